@@ -0,0 +1,79 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "csv_plot/csv_helpers.h"
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+
+namespace {
+
+// Writes a CSV file of roughly the given size with a time column and 20 signals
+std::string generateCsvFile(size_t size_bytes) {
+    constexpr int signal_count = 20;
+    std::string filename = (std::filesystem::temp_directory_path() / std::format("dbg_gui_benchmark_{}.csv", size_bytes)).string();
+    std::ofstream file(filename, std::ios::binary);
+    std::string line = "time";
+    for (int i = 0; i < signal_count; ++i) {
+        line += std::format(",signal{}", i);
+    }
+    file << line << '\n';
+    size_t written = line.size() + 1;
+    for (size_t row = 0; written < size_bytes; ++row) {
+        double time = double(row) * 1e-4;
+        line = std::format("{:g}", time);
+        for (int i = 0; i < signal_count; ++i) {
+            line += std::format(",{:.6g}", std::sin(time * (i + 1)));
+        }
+        file << line << '\n';
+        written += line.size() + 1;
+    }
+    return filename;
+}
+
+void benchmarkCsvParsing(size_t size_bytes) {
+    std::string filename = generateCsvFile(size_bytes);
+    BENCHMARK(std::format("read and parse {} MB", size_bytes >> 20)) {
+        std::expected<std::string, std::string> csv = str::readFile(filename);
+        return parseCsvColumns(csv.value());
+    };
+    std::filesystem::remove(filename);
+}
+
+} // namespace
+
+TEST_CASE("parseCsvColumns") {
+    benchmarkCsvParsing(size_t(16) << 20);
+    benchmarkCsvParsing(size_t(256) << 20);
+}
+
+// Several GB of disk and memory so not run by default
+TEST_CASE("parseCsvColumns on a multi-GB file", "[.large]") {
+    benchmarkCsvParsing(size_t(2) << 30);
+}
@@ -0,0 +1,91 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "minmax_kernel.h"
+#include "plot_decimation.h"
+
+#include <cmath>
+#include <format>
+#include <vector>
+
+namespace {
+
+void benchmarkDecimation(size_t point_count) {
+    std::vector<double> x(point_count);
+    std::vector<double> y(point_count);
+    for (size_t i = 0; i < point_count; ++i) {
+        x[i] = double(i) * 1e-4;
+        y[i] = std::sin(x[i] * 50) + 0.1 * std::sin(x[i] * 5000);
+    }
+    BENCHMARK(std::format("decimate {} points", point_count)) {
+        return decimateValues(x, y, MAX_PLOT_SAMPLE_COUNT);
+    };
+}
+
+} // namespace
+
+TEST_CASE("decimateValues") {
+    benchmarkDecimation(1'000'000);
+    benchmarkDecimation(10'000'000);
+}
+
+// 1.6 GB of samples so not run by default
+TEST_CASE("decimateValues on 1e8 points", "[.large]") {
+    benchmarkDecimation(100'000'000);
+}
+
+TEST_CASE("decimateValues with each min/max kernel") {
+    constexpr size_t POINT_COUNT = 10'000'000;
+    std::vector<double> x(POINT_COUNT);
+    std::vector<double> y(POINT_COUNT);
+    for (size_t i = 0; i < POINT_COUNT; ++i) {
+        x[i] = double(i) * 1e-4;
+        y[i] = std::sin(x[i] * 50);
+    }
+    MinMaxKernel startup_kernel = minMaxKernel();
+    for (auto [kernel, name] : {std::pair{MinMaxKernel::Scalar, "scalar"}, std::pair{MinMaxKernel::Sse2, "SSE2"}, std::pair{MinMaxKernel::Avx2, "AVX2"}}) {
+        if (setMinMaxKernel(kernel)) {
+            BENCHMARK(std::format("decimate {} points with {} kernel", POINT_COUNT, name)) {
+                return decimateValues(x, y, MAX_PLOT_SAMPLE_COUNT);
+            };
+        }
+    }
+    setMinMaxKernel(startup_kernel);
+}
+
+TEST_CASE("decimateValues on runs") {
+    // A mode word that changes every 100000 samples
+    constexpr size_t POINT_COUNT = 10'000'000;
+    std::vector<uint64_t> starts;
+    std::vector<double> values;
+    for (size_t i = 0; i < POINT_COUNT; i += 100'000) {
+        starts.push_back(i);
+        values.push_back(double(i / 100'000 % 4));
+    }
+    SampleView view{.values = RunSpan{.starts = starts, .values = values, .first = 0, .count = POINT_COUNT}};
+    BENCHMARK(std::format("decimate {} points in {} runs", POINT_COUNT, starts.size())) {
+        return decimateValues([](size_t i) { return double(i) * 1e-4; }, view, MAX_PLOT_SAMPLE_COUNT);
+    };
+}
@@ -0,0 +1,56 @@
+# Generates the sources of a library with many compilation units for
+# benchmarking symbol loading. Usage: generate_many_cu.py <output dir> <count>
+import sys
+from pathlib import Path
+
+CU_TEMPLATE = """#include <cstdint>
+
+namespace many_cu_{idx} {{
+enum class Mode {{
+    Off,
+    Starting,
+    Running,
+    Fault,
+}};
+
+struct Filter {{
+    double gain;
+    double state[4];
+}};
+
+struct State {{
+    Mode mode;
+    int32_t counter;
+    float values[16];
+    Filter filters[4];
+}};
+
+State state;
+double scalar;
+uint16_t flags;
+}} // namespace many_cu_{idx}
+"""
+
+ANCHOR = """
+#if defined(_WIN32)
+extern "C" __declspec(dllexport) int manyCuAnchor() {
+#else
+extern "C" int manyCuAnchor() {
+#endif
+    return 0;
+}
+"""
+
+
+def main():
+    output_dir = Path(sys.argv[1])
+    count = int(sys.argv[2])
+    for idx in range(count):
+        source = CU_TEMPLATE.format(idx=idx)
+        if idx == 0:
+            source += ANCHOR
+        (output_dir / f"many_cu_{idx}.cpp").write_text(source)
+
+
+if __name__ == "__main__":
+    main()
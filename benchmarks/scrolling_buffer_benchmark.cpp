@@ -0,0 +1,117 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "scrolling_buffer.h"
+
+#include <cmath>
+#include <format>
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr int BUFFER_SIZE = 100'000;
+// Rows sampled between drains, roughly one frame at 10 kHz sampling
+constexpr int ROWS_PER_DRAIN = 160;
+
+struct SampledSignals {
+    std::vector<double> values;
+    std::vector<std::unique_ptr<Scalar>> scalars;
+    ScrollingBuffer buffer{BUFFER_SIZE};
+
+    explicit SampledSignals(size_t count)
+        : values(count) {
+        for (size_t i = 0; i < count; ++i) {
+            auto scalar = std::make_unique<Scalar>();
+            scalar->id = i;
+            scalar->name = std::format("signal{}", i);
+            scalar->group = "benchmark";
+            scalar->alias = scalar->name;
+            scalar->updateDisplayNames();
+            scalar->src = &values[i];
+            buffer.startSampling(scalar.get());
+            scalars.push_back(std::move(scalar));
+        }
+        buffer.emptyTempBuffers();
+    }
+};
+
+} // namespace
+
+TEST_CASE("ScrollingBuffer sample and drain") {
+    for (size_t signal_count : {100, 1'000, 10'000, 50'000}) {
+        SampledSignals signals(signal_count);
+        double time = 0;
+        size_t row = 0;
+        BENCHMARK(std::format("sample {} signals", signal_count)) {
+            signals.buffer.sample(time);
+            time += 1e-4;
+            // The ring would fill up without draining, so drain on every
+            // frame worth of rows like the GUI does
+            if (++row % ROWS_PER_DRAIN == 0) {
+                signals.buffer.emptyTempBuffers();
+            }
+        };
+        BENCHMARK(std::format("sample and drain {} rows of {} signals", ROWS_PER_DRAIN, signal_count)) {
+            for (int i = 0; i < ROWS_PER_DRAIN; ++i) {
+                signals.buffer.sample(time);
+                time += 1e-4;
+            }
+            signals.buffer.emptyTempBuffers();
+        };
+    }
+}
+
+TEST_CASE("ScrollingBuffer plot a scrolling window") {
+    // One frame of rows is drained and the whole history is plotted like a
+    // live plot that is 2000 pixels wide
+    SampledSignals signals(10);
+    double time = 0;
+    for (int i = 0; i < BUFFER_SIZE; ++i) {
+        signals.values[0] = std::sin(time * 50);
+        signals.buffer.sample(time);
+        time += 1e-4;
+        if (i % ROWS_PER_DRAIN == 0) {
+            signals.buffer.emptyTempBuffers();
+        }
+    }
+    auto next_frame = [&]() {
+        for (int i = 0; i < ROWS_PER_DRAIN; ++i) {
+            signals.values[0] = std::sin(time * 50);
+            signals.buffer.sample(time);
+            time += 1e-4;
+        }
+        signals.buffer.emptyTempBuffers();
+    };
+    Scalar* scalar = signals.scalars[0].get();
+    BENCHMARK("decimate the window every frame") {
+        next_frame();
+        return signals.buffer.getValuesInRange(scalar, signals.buffer.getTimeIndices(0, time), 4000);
+    };
+    BENCHMARK("decimate the scrolled in buckets every frame") {
+        next_frame();
+        return signals.buffer.getCachedValuesInRange(scalar, signals.buffer.getTimeIndices(0, time), 4000);
+    };
+}
@@ -0,0 +1,46 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "spectrum.h"
+
+#include <cmath>
+#include <complex>
+#include <format>
+#include <numbers>
+#include <vector>
+
+TEST_CASE("calculateSpectrum") {
+    constexpr double sampling_time = 1e-4;
+    for (size_t sample_count : {1'024, 16'384, 100'000, 1'048'576}) {
+        std::vector<std::complex<double>> samples(sample_count);
+        for (size_t i = 0; i < sample_count; ++i) {
+            double t = double(i) * sampling_time;
+            samples[i] = {std::cos(2 * std::numbers::pi * 50 * t), std::sin(2 * std::numbers::pi * 50 * t)};
+        }
+        BENCHMARK(std::format("{} samples with Hann window", sample_count)) {
+            return calculateSpectrum(samples, sampling_time, SpectrumWindow::Hann, false, 0);
+        };
+    }
+}
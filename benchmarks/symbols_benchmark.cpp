@@ -0,0 +1,43 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "symbols/dbg_symbols.hpp"
+#include "symbols/variant_symbol.h"
+
+// Defined in the generated library that is linked into the benchmarks so that
+// its compilation units are loaded with the process
+extern "C" int manyCuAnchor();
+
+TEST_CASE("DbgSymbols") {
+    REQUIRE(manyCuAnchor() == 0);
+    BENCHMARK("load symbols of a binary with many compilation units") {
+        return DbgSymbols().symbolLoadErrors().size();
+    };
+
+    DbgSymbols const& symbols = DbgSymbols::getSymbols();
+    BENCHMARK("fuzzy search") {
+        return symbols.findMatchingSymbols("many_cu_1.state", 2, 1000);
+    };
+}
@@ -22,8 +22,33 @@
 
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 
+// Values of one signal for every timestamp of DbgGui_sampleBatch
+typedef struct {
+    const void* src;      // Pointer given to DbgGui_addScalar when the signal was added
+    const double* values; // One value per timestamp
+} DbgGui_SampleBlock;
+
+// How accurately sampling is paced to the simulation speed, in seconds
+typedef struct {
+    uint64_t sync_count; // Number of waits for the wall clock
+    double mean_error;   // Mean time the waits ended late
+    double max_error;    // Maximum time a wait ended late
+} DbgGui_PacingStatistics;
+
+// Time spent by DbgGui in one part of sampling or drawing, in seconds
+typedef struct {
+    const char* name;
+    uint64_t count;
+    double total_time;
+    double max_time;
+} DbgGui_ProfileSection;
+
+// Separate time base and sample buffer for signals sampled from another thread
+typedef struct DbgGui_SamplingDomain DbgGui_SamplingDomain;
+
 // C++ api
 #ifdef __cplusplus
 #include <functional>
@@ -31,6 +56,7 @@
 #include <string>
 #include <utility>
 #include <variant>
+#include <vector>
 using ReadWriteFn = std::function<double(std::optional<double>)>;
 using ReadWriteFnCustomStr = std::function<std::pair<std::string, double>(std::optional<double>)>;
 using ValueSource = std::variant<
@@ -50,6 +76,7 @@ using ValueSource = std::variant<
 void DbgGui_addScalar(ValueSource const& src, std::string const& group, std::string const& name, double scale = 1.0, double offset = 0.0);
 void DbgGui_addVector(ValueSource const& x, ValueSource const& y, std::string const& group, std::string const& name, double scale = 1.0, double offset = 0.0);
 void DbgGui_addSymbol(std::string const& src, std::string const& group, std::string const& name, double scale = 1.0, double offset = 0.0);
+void DbgGui_sampleBatch(std::vector<double> const& timestamps, std::vector<DbgGui_SampleBlock> const& blocks);
 #endif
 
 // C-api
@@ -71,11 +98,41 @@ void DbgGui_addScalar_f64(double* src, const char* group, const char* name);
 
 void DbgGui_addVector_f32(float* x, float* y, const char* group, const char* name);
 void DbgGui_addVector_f64(double* x, double* y, const char* group, const char* name);
+// Read the signal only on every Nth sample, e.g. for slowly changing signals
+void DbgGui_setSampleDivider(const char* group, const char* name, uint32_t divider);
+
+// Each domain is sampled from its own thread with DbgGui_sampleDomain without
+// contention with the other domains. Domains are plotted on the same time axis
+// so their timestamps should share a time base, e.g. DbgGui_wallClockTime().
+// Scripts, pause triggers, captures and speed synchronization only follow the
+// main sampling.
+DbgGui_SamplingDomain* DbgGui_addSamplingDomain(const char* name);
+// Moves the signal from the main sampling to the domain or back with NULL.
+// The components of a vector move together.
+void DbgGui_setSamplingDomain(const char* group, const char* name, DbgGui_SamplingDomain* domain);
+void DbgGui_sampleDomain(DbgGui_SamplingDomain* domain, double timestamp);
+// Seconds since DbgGui_create
+double DbgGui_wallClockTime(void);
 
 void DbgGui_create(double sampling_time);
 void DbgGui_startUpdateLoop(void);
 void DbgGui_sample(void);
 void DbgGui_sampleWithTimestamp(double timestamp);
+// Samples count rows at once, e.g. after a solver has computed several steps.
+// Signals in blocks take their values from the block. Other signals are read
+// once and repeated for every row. Timestamps must be in increasing order.
+void DbgGui_sampleBatch(const double* timestamps, size_t count, const DbgGui_SampleBlock* blocks, size_t block_count);
+// Samples on a background thread every sampling_time seconds of wall clock
+// time for applications without a loop of their own. Do not call the other
+// sampling functions after this. Missed deadlines are reported in the log.
+void DbgGui_startBackgroundSampling(double sampling_time);
+// Pacing during the previous second of sampling
+DbgGui_PacingStatistics DbgGui_getPacingStatistics(void);
+// Measures the time DbgGui spends in sampling and drawing. Can also be enabled
+// from the performance window.
+void DbgGui_setProfilingEnabled(int enabled);
+// Copies at most max_count sections and returns the number of sections
+size_t DbgGui_getProfile(DbgGui_ProfileSection* sections, size_t max_count);
 int DbgGui_isClosed(void);
 void DbgGui_close(void);
 void DbgGui_pause(void);
@@ -0,0 +1,134 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+
+// Calls a function at a fixed wall clock rate on its own thread for
+// applications that have no loop of their own to sample from. Deadlines are
+// absolute so that wake-up jitter does not accumulate into drift. The thread
+// sleeps until shortly before the deadline and yields for the rest because
+// sleeps are much coarser than typical sampling periods on some systems.
+class BackgroundSampler {
+  public:
+    // The callback is called with the sample time, which advances by period on
+    // every call and also over missed deadlines.
+    BackgroundSampler(double period, std::function<void(double)> callback, double start_time = 0)
+        : m_period(period),
+          m_callback(std::move(callback)),
+          m_start_time(start_time) {
+    }
+
+    ~BackgroundSampler() {
+        stop();
+    }
+
+    BackgroundSampler(BackgroundSampler const&) = delete;
+    BackgroundSampler& operator=(BackgroundSampler const&) = delete;
+
+    void start() {
+        m_thread = std::jthread([this](std::stop_token stop) { run(stop); });
+    }
+
+    void stop() {
+        if (m_thread.joinable()) {
+            m_thread.request_stop();
+            m_thread.join();
+        }
+    }
+
+    // Starts a new schedule from the current time without counting the
+    // deadlines in between as missed, e.g. after the callback has been blocked
+    // while paused. The sample time continues from the previous sample.
+    void restartSchedule() {
+        m_restart = true;
+    }
+
+    // Number of samples skipped because their deadline had already passed
+    uint64_t takeMissedDeadlineCount() {
+        return m_missed_deadlines.exchange(0);
+    }
+
+    double period() const {
+        return m_period;
+    }
+
+    bool isSamplingThread() const {
+        return std::this_thread::get_id() == m_thread_id.load();
+    }
+
+  private:
+    using Clock = std::chrono::steady_clock;
+    // Sleeps shorter than this are done by yielding
+    static constexpr std::chrono::microseconds SPIN_TIME{1000};
+
+    void run(std::stop_token stop) {
+        m_thread_id = std::this_thread::get_id();
+        Clock::duration const period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(m_period));
+        Clock::time_point deadline = Clock::now();
+        double time = m_start_time;
+        while (!stop.stop_requested()) {
+            m_callback(time);
+            time += m_period;
+            deadline += period;
+            Clock::time_point now = Clock::now();
+            if (m_restart.exchange(false)) {
+                deadline = now + period;
+            } else if (period.count() > 0 && now - deadline >= period) {
+                // Deadlines that passed while the callback ran are skipped
+                // instead of sampled in a burst
+                uint64_t missed = uint64_t((now - deadline) / period);
+                deadline += missed * period;
+                time += double(missed) * m_period;
+                m_missed_deadlines += missed;
+            }
+            sleepUntil(deadline, stop);
+        }
+    }
+
+    void sleepUntil(Clock::time_point deadline, std::stop_token const& stop) {
+        if (deadline - Clock::now() > SPIN_TIME) {
+            std::unique_lock lock(m_sleep_mutex);
+            m_sleep_cv.wait_until(lock, stop, deadline - SPIN_TIME, [] { return false; });
+        }
+        while (Clock::now() < deadline && !stop.stop_requested()) {
+            std::this_thread::yield();
+        }
+    }
+
+    double m_period;
+    std::function<void(double)> m_callback;
+    double m_start_time;
+    std::atomic<bool> m_restart = false;
+    std::atomic<uint64_t> m_missed_deadlines = 0;
+    std::atomic<std::thread::id> m_thread_id;
+    std::mutex m_sleep_mutex;
+    std::condition_variable_any m_sleep_cv;
+    std::jthread m_thread;
+};
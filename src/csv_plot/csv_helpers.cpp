@@ -30,6 +30,7 @@
 #include <limits>
 #include <format>
 #include <map>
+#include <charconv>
 
 std::vector<std::string_view> splitWhitespace(std::string const& s, int expected_column_count) {
     std::vector<std::string_view> elems;
@@ -180,6 +181,78 @@ std::vector<std::string> makeUniqueCsvSignalNames(std::vector<std::string> const
     return unique_names;
 }
 
+std::expected<CsvColumns, std::string> parseCsvColumns(std::string_view csv) {
+    std::vector<std::string_view> csv_lines = str::splitSv(csv, '\n');
+    if (csv_lines.size() < 3) {
+        return std::unexpected("less than 3 lines of data");
+    }
+    std::string third_last_line = std::string(csv_lines[csv_lines.size() - 3]);
+    str::trim(third_last_line);
+    if (third_last_line.empty()) {
+        return std::unexpected("no data");
+    }
+
+    // Try detect delimiter from the end of file as that part likely doesn't contain extra information
+    // Use third last line in case the last line gets modified suddenly
+    char delimiter = '\0';
+    size_t element_count = 0;
+    std::vector<std::string> values_comma = str::split(third_last_line, ',');
+    std::vector<std::string> values_semicolon = str::split(third_last_line, ';');
+    std::vector<std::string> values_tab = str::split(third_last_line, '\t');
+    if (values_comma.size() > values_semicolon.size() && values_comma.size() > values_tab.size()) {
+        delimiter = ',';
+        element_count = values_comma.size();
+    } else if (values_semicolon.size() > values_comma.size() && values_semicolon.size() > values_tab.size()) {
+        delimiter = ';';
+        element_count = values_semicolon.size();
+    } else if (values_tab.size() > values_comma.size() && values_tab.size() > values_semicolon.size()) {
+        delimiter = '\t';
+        element_count = values_tab.size();
+    }
+    if (delimiter == '\0') {
+        return std::unexpected("unable to detect delimiter from third last line");
+    }
+
+    // Find first line where header begins
+    size_t header_line_idx = 0;
+    for (std::string_view line_sv : csv_lines) {
+        std::string line(line_sv);
+        str::trim(line);
+        if (str::splitSv(line, delimiter).size() == element_count) {
+            break;
+        }
+        ++header_line_idx;
+    }
+    if (header_line_idx >= csv_lines.size()) {
+        return std::unexpected("unable to find CSV header");
+    }
+    std::string header_line(csv_lines[header_line_idx]);
+    str::trim(header_line);
+    CsvColumns csv_columns;
+    csv_columns.names = str::split(header_line, delimiter);
+    if (csv_columns.names.empty()) {
+        return std::unexpected("no signals found");
+    }
+
+    csv_columns.columns.resize(csv_columns.names.size());
+    for (size_t i = header_line_idx + 1; i < csv_lines.size(); ++i) {
+        std::string line = str::removeWhitespace(csv_lines[i]);
+        std::vector<std::string_view> values = str::splitSv(line, delimiter, (int)csv_columns.names.size());
+        if (values.size() != csv_columns.names.size()) {
+            break;
+        }
+        for (size_t j = 0; j < values.size(); ++j) {
+            double value;
+            std::from_chars_result result = std::from_chars(values[j].data(), values[j].data() + values[j].size(), value);
+            if (result.ec != std::errc()) {
+                value = NAN;
+            }
+            csv_columns.columns[j].push_back(value);
+        }
+    }
+    return csv_columns;
+}
+
 double getPlotValueAtX(CsvPlotStyle plot_style,
                        std::span<double const> x,
                        std::span<double const> y,
@@ -23,6 +23,7 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <expected>
 #include <span>
 #include <string_view>
 
@@ -41,6 +42,16 @@ std::string formatCsvColumns(std::vector<std::string> const& header,
                              std::vector<std::vector<double>> const& data);
 std::vector<std::string> makeUniqueCsvSignalNames(std::vector<std::string> const& signal_names);
 
+struct CsvColumns {
+    std::vector<std::string> names;
+    std::vector<std::vector<double>> columns;
+};
+
+// Parses CSV text delimited with ',', ';' or tabs. The delimiter and column
+// count are detected from the end of the text and lines before the header are
+// skipped. Values that are not numbers are NaN.
+std::expected<CsvColumns, std::string> parseCsvColumns(std::string_view csv);
+
 // Opens PSCAD .inf file, reads the signal names, parses the .out files for data and creates single
 // csv file with same basename. Returns true if csv file was created, false if something went wrong.
 bool pscadInfToCsv(std::string const& inf_filename);
@@ -48,6 +48,7 @@ inline const std::string SETTINGS_LOCATION = "HOME";
 #include "save_image.h"
 #include "multi_select_helpers.h"
 #include "csv_helpers.h"
+#include "history_file.h"
 #include "custom_signal.hpp"
 #include "imgui_settings_migration.h"
 #include "minmax.h"
@@ -94,10 +95,12 @@ inline float COMPARISON_MODE_ACTIVATION_TIME = 0.5f;
 std::vector<double> ASCENDING_NUMBERS;
 
 std::unique_ptr<CsvFileData> parseCsvData(std::string filename);
+std::unique_ptr<CsvFileData> makeCsvFileData(std::string const& filename, std::vector<CsvSignal> csv_signals);
 std::vector<std::unique_ptr<CsvFileData>> openCsvFromFileDialog();
 std::vector<std::string> openDialogMultiple();
 void setLayout(ImGuiID main_dock, int rows, int cols, float signals_window_width);
 std::pair<int32_t, int32_t> getTimeIndices(std::span<double const> time, double start_time, double end_time);
+DecimatedValues decimatePlotRange(std::span<double const> x_values, std::span<double const> y_values, PlotPrefetch::Request const& request, bool fit_data);
 
 std::optional<int> parseInt(std::string_view text) {
     int value = 0;
@@ -226,6 +229,23 @@ std::pair<int32_t, int32_t> getTimeIndices(std::span<double const> time, double
     return {start_idx, end_idx};
 }
 
+// Decimates the samples within the x-axis limits of the request. The x-axis
+// of the plot is shifted from the samples by the x offset of the transform.
+DecimatedValues decimatePlotRange(std::span<double const> x_values, std::span<double const> y_values, PlotPrefetch::Request const& request, bool fit_data) {
+    size_t sample_count = MIN(x_values.size(), y_values.size());
+    x_values = x_values.first(sample_count);
+    y_values = y_values.first(sample_count);
+    double x_offset = -request.transform.x_offset;
+    std::pair<int32_t, int32_t> indices = getTimeIndices(x_values, request.start + x_offset, request.end + x_offset);
+    size_t range_start = size_t(std::clamp(indices.first, 0, int32_t(sample_count)));
+    size_t range_end = size_t(std::clamp(indices.second, int32_t(range_start), int32_t(sample_count)));
+    if (fit_data) {
+        range_start = 0;
+        range_end = sample_count;
+    }
+    return decimateValues(x_values, y_values, range_start, range_end, request.count, request.transform);
+}
+
 void CsvPlotter::applySignalTransforms(CsvFileData& file) {
     for (CsvSignal& signal : file.signals) {
         auto transform_it = m_signal_transform_settings.find(signal.name);
@@ -1116,6 +1136,8 @@ CsvPlotter::CsvPlotter(std::vector<std::string> files,
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
         ImGui::NewFrame();
+        // Nothing that the preparation reads may change before it is done
+        m_plot_prefetch.wait();
         ImGuiID main_dock = ImGui::DockSpaceOverViewport(0, ImGui::GetMainViewport());
         // ImGui::ShowDemoWindow();
         // ImPlot::ShowDemoWindow();
@@ -1140,6 +1162,9 @@ CsvPlotter::CsvPlotter(std::vector<std::string> files,
 
         //---------- Rendering ----------
         ImGui::Render();
+        // The draw data has its own copy of the plotted values so the plots of
+        // the next frame are prepared in the background while this one renders
+        prepareScalarPlots();
         int display_w, display_h;
         glfwGetFramebufferSize(m_window, &display_w, &display_h);
         glViewport(0, 0, display_w, display_h);
@@ -1163,6 +1188,7 @@ CsvPlotter::CsvPlotter(std::vector<std::string> files,
             glfwSetWindowShouldClose(m_window, true);
         }
     }
+    m_plot_prefetch.wait();
 
     // Cleanup
     ImGui_ImplOpenGL3_Shutdown();
@@ -1531,6 +1557,28 @@ void CsvPlotter::updateSavedSettings(bool force) {
 }
 
 std::unique_ptr<CsvFileData> parseCsvData(std::string filename) {
+    if (filename.ends_with(HISTORY_FILE_EXTENSION)) {
+        // Sample history recorded by DbgGui is read directly without conversion
+        std::expected<HistoryFileData, std::string> history = readHistoryFile(filename);
+        if (!history.has_value()) {
+            std::cerr << history.error() << std::endl;
+            return nullptr;
+        }
+        if (history->columns[0].empty()) {
+            std::cerr << "No data in file " + filename << std::endl;
+            return nullptr;
+        }
+        std::vector<CsvSignal> csv_signals;
+        csv_signals.reserve(history->names.size());
+        for (std::string const& signal_name : makeUniqueCsvSignalNames(history->names)) {
+            csv_signals.push_back(CsvSignal{.name = signal_name});
+        }
+        for (size_t i = 0; i < csv_signals.size(); ++i) {
+            csv_signals[i].samples = std::move(history->columns[i]);
+        }
+        return makeCsvFileData(filename, std::move(csv_signals));
+    }
+
     std::string csv_filename = filename;
     if (filename.ends_with(".inf")) {
         bool csv_file_created = pscadInfToCsv(filename);
@@ -1559,83 +1607,24 @@ std::unique_ptr<CsvFileData> parseCsvData(std::string filename) {
         std::cerr << csv_str.error() << std::endl;
         return nullptr;
     }
-    std::vector<std::string_view> csv_lines = str::splitSv(csv_str.value(), '\n');
-    if (csv_lines.size() < 3) {
-        std::cerr << "File " + csv_filename << " has less than 3 lines of data" << std::endl;
-        return nullptr;
-    }
-    std::string third_last_line = std::string(csv_lines[csv_lines.size() - 3]);
-    str::trim(third_last_line);
-    if (third_last_line.empty()) {
-        std::cerr << "No data in file " + csv_filename << std::endl;
-        return nullptr;
-    }
-
-    // Try detect delimiter from the end of file as that part likely doesn't contain extra information
-    // Use third last line in case the last line gets modified suddenly
-    char delimiter = '\0';
-    size_t element_count = 0;
-    std::vector<std::string> values_comma = str::split(third_last_line, ',');
-    std::vector<std::string> values_semicolon = str::split(third_last_line, ';');
-    std::vector<std::string> values_tab = str::split(third_last_line, '\t');
-    if (values_comma.size() > values_semicolon.size() && values_comma.size() > values_tab.size()) {
-        delimiter = ',';
-        element_count = values_comma.size();
-    } else if (values_semicolon.size() > values_comma.size() && values_semicolon.size() > values_tab.size()) {
-        delimiter = ';';
-        element_count = values_semicolon.size();
-    } else if (values_tab.size() > values_comma.size() && values_tab.size() > values_semicolon.size()) {
-        delimiter = '\t';
-        element_count = values_tab.size();
-    }
-    if (delimiter == '\0') {
-        std::cerr << std::format("Unable to detect delimiter from third last line of the file \"{}\"\n", csv_filename);
-        return nullptr;
-    }
-
-    // Find first line where header begins
-    int header_line_idx = 0;
-    for (std::string_view line_sv : csv_lines) {
-        std::string line(line_sv);
-        str::trim(line);
-        if (str::splitSv(line, delimiter).size() == element_count) {
-            break;
-        }
-        ++header_line_idx;
-    }
-    if (header_line_idx >= csv_lines.size()) {
-        std::cerr << std::format("Unable to find CSV header in file \"{}\"\n", csv_filename);
-        return nullptr;
-    }
-    std::string header_line(csv_lines[header_line_idx]);
-    str::trim(header_line);
-    std::vector<std::string> signal_names = str::split(header_line, delimiter);
-    if (signal_names.empty()) {
-        std::cerr << std::format("No signals found in CSV file \"{}\"\n", csv_filename);
+    std::expected<CsvColumns, std::string> csv_columns = parseCsvColumns(csv_str.value());
+    if (!csv_columns.has_value()) {
+        std::cerr << std::format("Unable to read file \"{}\": {}\n", csv_filename, csv_columns.error());
         return nullptr;
     }
 
     std::vector<CsvSignal> csv_signals;
-    csv_signals.reserve(signal_names.size());
-    for (std::string const& signal_name : makeUniqueCsvSignalNames(signal_names)) {
+    csv_signals.reserve(csv_columns->names.size());
+    for (std::string const& signal_name : makeUniqueCsvSignalNames(csv_columns->names)) {
         csv_signals.push_back(CsvSignal{.name = signal_name});
     }
-    for (int i = header_line_idx + 1; i < csv_lines.size(); ++i) {
-        std::string line = str::removeWhitespace(csv_lines[i]);
-        std::vector<std::string_view> values = str::splitSv(line, delimiter, (int)csv_signals.size());
-        if (values.size() != signal_names.size()) {
-            break;
-        }
-        for (size_t j = 0; j < values.size(); ++j) {
-            double value;
-            std::from_chars_result result = std::from_chars(values[j].data(), values[j].data() + values[j].size(), value);
-            if (result.ec != std::errc()) {
-                value = NAN;
-            }
-            csv_signals[j].samples.push_back(value);
-        }
+    for (size_t i = 0; i < csv_signals.size(); ++i) {
+        csv_signals[i].samples = std::move(csv_columns->columns[i]);
     }
+    return makeCsvFileData(filename, std::move(csv_signals));
+}
 
+std::unique_ptr<CsvFileData> makeCsvFileData(std::string const& filename, std::vector<CsvSignal> csv_signals) {
     // Sort signals alphabetically, skip first since that is usually time
     std::sort(csv_signals.begin() + 1, csv_signals.end(), [](CsvSignal const& l, CsvSignal const& r) {
         std::string l_name = l.name;
@@ -2215,6 +2204,40 @@ void CsvPlotter::showSignalWindow() {
     }
 }
 
+// Decimates the scalar plots in parallel for the limits and size that they had
+// in the previous frame, which is what they will most likely ask for.
+void CsvPlotter::prepareScalarPlots() {
+    for (int visible_plot_idx = 0; visible_plot_idx < activePlotCount(); ++visible_plot_idx) {
+        PlotBase& plot_base = plotAt(visible_plot_idx);
+        if (plot_base.plotType() != CsvPlotType::Scalar) {
+            continue;
+        }
+        ScalarPlot const& plot = std::get<ScalarPlot>(plot_base.variant);
+        if (plot.prepared_point_count <= 0 || plot.autofit_next_frame) {
+            continue;
+        }
+        double plot_x_origin = getScalarPlotXOrigin(plot);
+        for (CsvSignal* signal : plot.signals) {
+            if (!signal->file->enabled) {
+                continue;
+            }
+            std::span<double const> x_values = getXSignalSamples(*signal->file);
+            std::span<double const> y_values(signal->samples);
+            double x_offset = plot_x_origin - signal->file->x_axis_shift;
+            PlotPrefetch::Request request{.plot = &plot,
+                                          .signal = signal,
+                                          .start = plot.prepared_x_limits.min,
+                                          .end = plot.prepared_x_limits.max,
+                                          .count = plot.prepared_point_count,
+                                          .transform = {.x_offset = -x_offset,
+                                                        .y_scale = signal->transform.scale,
+                                                        .y_offset = signal->transform.offset}};
+            m_plot_prefetch.add(request, [=]() { return decimatePlotRange(x_values, y_values, request, false); });
+        }
+    }
+    m_plot_prefetch.start(m_worker_pool);
+}
+
 void CsvPlotter::showPlots() {
     // Scalar plots share an aligned-plot group so their axis padding lines up. Vector
     // and spectrum plots would be forced into that scalar alignment if rendered
@@ -2363,18 +2386,20 @@ void CsvPlotter::showScalarPlot(PlotBase& plot_base, int visible_plot_idx, doubl
         }
 
         int point_count = int(2.0f * ImPlot::GetPlotSize().x);
+        // Collect only values that are within plot range so that the autofit fits to the plotted values instead
+        // of the entire data
+        ImPlotRect limits = ImPlot::GetPlotLimits();
+        if (autofit_x_axis) {
+            limits.X.Min = -INFINITY;
+            limits.X.Max = INFINITY;
+        }
+        plot.prepared_x_limits = {limits.X.Min, limits.X.Max};
+        plot.prepared_point_count = point_count;
         CsvSignal* signal_to_remove = nullptr;
         for (CsvSignal* signal : plot.signals) {
             if (!signal->file->enabled) {
                 continue;
             }
-            // Collect only values that are within plot range so that the autofit fits to the plotted values instead
-            // of the entire data
-            ImPlotRect limits = ImPlot::GetPlotLimits();
-            if (autofit_x_axis) {
-                limits.X.Min = -INFINITY;
-                limits.X.Max = INFINITY;
-            }
             std::span<double const> x_values = getXSignalSamples(*signal->file);
             std::span<double const> y_values(signal->samples);
             size_t sample_count = MIN(x_values.size(), y_values.size());
@@ -2384,23 +2409,19 @@ void CsvPlotter::showScalarPlot(PlotBase& plot_base, int visible_plot_idx, doubl
             x_values = x_values.first(sample_count);
             y_values = y_values.first(sample_count);
             double x_offset = plot_x_origin - signal->file->x_axis_shift;
-            std::pair<int32_t, int32_t> indices = getTimeIndices(x_values, limits.X.Min + x_offset, limits.X.Max + x_offset);
-            size_t range_start = size_t(std::clamp(indices.first, 0, int32_t(sample_count)));
-            size_t range_end = size_t(std::clamp(indices.second, int32_t(range_start), int32_t(sample_count)));
-            if (fit_data) {
-                range_start = 0;
-                range_end = sample_count;
-            }
 
             // Decimate values because plotting very large amount of samples is slow and the GUI becomes unresponsive
-            DecimatedValues plotted_values = decimateValues(x_values,
-                                                            y_values,
-                                                            range_start,
-                                                            range_end,
-                                                            point_count,
-                                                            {.x_offset = -x_offset,
-                                                             .y_scale = signal->transform.scale,
-                                                             .y_offset = signal->transform.offset});
+            PlotPrefetch::Request request{.plot = &plot,
+                                          .signal = signal,
+                                          .start = limits.X.Min,
+                                          .end = limits.X.Max,
+                                          .count = point_count,
+                                          .transform = {.x_offset = -x_offset,
+                                                        .y_scale = signal->transform.scale,
+                                                        .y_offset = signal->transform.offset}};
+            DecimatedValues plotted_values = fit_data
+                                             ? decimatePlotRange(x_values, y_values, request, true)
+                                             : m_plot_prefetch.take(request, [&]() { return decimatePlotRange(x_values, y_values, request, false); });
 
             std::stringstream ss;
             ss << std::left << std::setw(longest_name_length) << signal->name << " | " << signal->file->displayed_name;
@@ -2529,7 +2550,7 @@ void CsvPlotter::showScalarPlot(PlotBase& plot_base, int visible_plot_idx, doubl
 std::vector<std::string> openDialogMultiple() {
     nfdpathset_t path_set;
     static std::filesystem::path dir = std::filesystem::current_path();
-    nfdresult_t result = NFD_OpenDialogMultiple("csv,inf", dir.string().c_str(), &path_set);
+    nfdresult_t result = NFD_OpenDialogMultiple("csv,inf,dbghist", dir.string().c_str(), &path_set);
     std::vector<std::string> paths;
     if (result == NFD_OKAY) {
         for (int i = 0; i < path_set.count; ++i) {
@@ -22,6 +22,7 @@
 #pragma once
 
 #include "plot_base.h"
+#include "plot_prefetch.h"
 #include "themes.h"
 #include "imgui.h"
 #include "imgui_helpers.h"
@@ -34,6 +35,7 @@
 #include <vector>
 #include <optional>
 #include "csv_helpers.h"
+#include "worker_pool.h"
 
 inline constexpr int NOT_VISIBLE = -1;
 inline constexpr ImVec4 NO_COLOR = {-1, -1, -1, -1};
@@ -102,6 +104,7 @@ class CsvPlotter {
     std::vector<CommandPaletteCommand> commandPaletteCommands(bool enable_hotkeys = true);
     void showCustomSignalCreator();
     void showSignalWindow();
+    void prepareScalarPlots();
     void showPlots();
     void showScalarPlot(PlotBase& plot_base, int visible_plot_idx, double& vertical_line_time, double& vertical_line_time_next);
     void showVectorPlot(PlotBase& plot_base, int visible_plot_idx);
@@ -149,6 +152,8 @@ class CsvPlotter {
     GLFWwindow* m_window;
 
     std::vector<std::unique_ptr<CsvFileData>> m_csv_data;
+    WorkerPool m_worker_pool;
+    PlotPrefetch m_plot_prefetch;
     std::map<std::string, CsvSignalTransform> m_signal_transform_settings;
     std::map<std::string, CsvPlotStyle> m_signal_plot_style_settings;
     CommandHotkeyOverrides m_hotkey_overrides;
@@ -57,6 +57,9 @@ struct CsvPlotSignalSettings {
 struct ScalarPlot {
     std::vector<CsvSignal*> signals;
     bool autofit_next_frame = false;
+    // X-axis limits and points of the previous frame for preparing the next frame
+    MinMax prepared_x_limits = {0, 0};
+    int prepared_point_count = 0;
 
     void addSignal(CsvSignal* signal) {
         if (contains(signals, signal)) {
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include "DbgGui/dbg_gui.h"
 #include "symbols/dbg_symbols.hpp"
 #include "symbols/arithmetic_symbol.h"
 #include "imgui.h"
@@ -132,6 +133,10 @@ struct Scalar {
     ValueSource src;
     bool read_only = false;
     bool hide_from_scalars_window = false;
+    // Sampled on every Nth sample
+    uint32_t sample_divider = 1;
+    // Sampled with the main sampling if null
+    DbgGui_SamplingDomain* sampling_domain = nullptr;
     bool deleted = false;
     Scalar* replacement = nullptr;
 
@@ -164,6 +169,7 @@ struct Scalar {
         j["scale"] = getScaleStr();
         j["offset"] = getOffsetStr();
         j["alias"] = alias;
+        j["sample_divider"] = sample_divider;
         return j;
     }
 
@@ -320,6 +326,8 @@ struct ScalarPlot : Window {
         std::vector<Scalar*> scalars;
         MinMax y_axis = {-1, 1};
         bool autofit_y = true;
+        // Points plotted in the previous frame for preparing the next frame
+        int point_count = 0;
     };
 
     inline static constexpr int MAX_SUBPLOT_ROWS = 10;
@@ -84,6 +84,7 @@ std::vector<Scalar*> restoreScalarSettings(Scalar* scalar,
             scalar->setOffsetStr(offset);
             scalar->alias = std::string(scalar_data["alias"]);
             scalar->updateDisplayNames();
+            scalar->sample_divider = std::max(scalar_data.value("sample_divider", 1u), 1u);
             break;
         }
     })
@@ -226,6 +227,8 @@ Vector2D* findVector(std::vector<std::unique_ptr<Vector2D>> const& vectors, uint
 }
 
 constexpr int SETTINGS_CHECK_INTERVAL_MS = 500;
+// Oldest captures are dropped after this many
+constexpr size_t MAX_CAPTURES = 50;
 
 uint64_t hash(const std::string& str) {
     uint64_t hash = 5381;
@@ -259,42 +262,38 @@ DbgGui::~DbgGui() {
 
 void DbgGui::startUpdateLoop() {
     m_gui_thread = std::jthread(&DbgGui::updateLoop, std::ref(*this));
-    while (!m_initialized) {
-    }
+    m_initialized.wait(false);
 }
 
 void DbgGui::synchronizeSpeed() {
-    using namespace std::chrono;
-    static double sync_interval = 30e-3;
-    static auto last_real_timestamp = std::chrono::system_clock::now();
-    static double last_timestamp = m_sample_timestamp;
-    static std::future<void> tick;
-
-    if (m_sample_timestamp > m_next_sync_timestamp || (tick.valid() && tick.wait_for(std::chrono::seconds(0)) == std::future_status::ready)) {
-        // Wait until next tick
-        if (tick.valid()) {
-            tick.wait();
-        }
-        tick = std::async(std::launch::async,
-                          []() {
-                              std::this_thread::sleep_for(std::chrono::milliseconds(30));
-                          });
-        m_next_sync_timestamp = m_sample_timestamp + sync_interval * m_simulation_speed;
-
-        auto now = std::chrono::system_clock::now();
-        auto real_time_us = std::chrono::duration_cast<microseconds>(now - last_real_timestamp).count();
-        real_time_us = std::max<long>(real_time_us, 1);
-        double real_time_s = real_time_us * 1e-6;
-        last_real_timestamp = now;
-
-        // Adjust the sync interval for more accurate synchronization
-        double simulation_speed = (m_sample_timestamp - last_timestamp) / real_time_s;
-        double sync_interval_ki = 1e-2;
-        sync_interval += sync_interval_ki * (m_simulation_speed - simulation_speed);
-        sync_interval = std::clamp(sync_interval, 1e-3, 100e-3);
-
-        last_timestamp = m_sample_timestamp;
+    // Zero is set while paused and after time jumps so that the new speed or
+    // time is taken into use immediately
+    if (m_next_sync_timestamp == 0) {
+        m_pacing_clock.restart(m_sample_timestamp);
+    } else if (m_sample_timestamp < m_next_sync_timestamp) {
+        return;
+    } else {
+        m_pacing_clock.waitUntil(m_sample_timestamp, m_simulation_speed);
+    }
+    double const sync_interval = std::max(m_options.sync_interval_ms, 1) * 1e-3;
+    m_next_sync_timestamp = m_sample_timestamp + sync_interval * m_simulation_speed;
+}
+
+DbgGui_PacingStatistics DbgGui::pacingStatistics() {
+    return m_pacing_clock.statistics();
+}
+
+void DbgGui::setProfilingEnabled(bool enabled) {
+    m_profiler.setEnabled(enabled);
+}
+
+std::vector<DbgGui_ProfileSection> DbgGui::profile() {
+    std::vector<DbgGui_ProfileSection> sections;
+    for (size_t i = 0; i < size_t(ProfileSection::Count); ++i) {
+        Profiler::Totals totals = m_profiler.totals(ProfileSection(i));
+        sections.push_back({PROFILE_SECTION_NAMES[i], totals.count, totals.total_time, totals.max_time});
     }
+    return sections;
 }
 
 void DbgGui::sample() {
@@ -302,32 +301,54 @@ void DbgGui::sample() {
 }
 
 void DbgGui::sampleWithTimestamp(double timestamp) {
+    sampleBatch(std::span(&timestamp, 1), {});
+}
+
+void DbgGui::sampleBatch(std::span<double const> timestamps, std::span<DbgGui_SampleBlock const> blocks) {
     // No point sampling if window has been closed
-    if (isClosed()) {
+    if (isClosed() || timestamps.empty()) {
         return;
     }
 
     {
-        // Sample scalars
+        // Scripts and pause triggers are shared with the GUI thread. Sampled
+        // values go through a lock-free ring so the GUI only takes this mutex
+        // for short script and trigger edits, never while drawing a frame.
+        ProfileScope lock_wait(m_profiler, ProfileSection::SamplingLockWait);
         std::scoped_lock<std::mutex> lock(m_sampling_mutex);
-        if (timestamp < m_sample_timestamp) {
-            double const time_offset = timestamp - m_sample_timestamp;
+        lock_wait.stop();
+        if (timestamps.front() < m_sample_timestamp) {
+            double const time_offset = timestamps.front() - m_sample_timestamp;
             m_sampler.shiftTime(time_offset);
             for (ScriptWindow& script_window : m_script_windows) {
                 script_window.shiftScriptSchedule(time_offset);
             }
             m_next_sync_timestamp = 0;
         }
-        m_sample_timestamp = timestamp;
+        m_sample_timestamp = timestamps.back();
 
-        for (ScriptWindow& script_window : m_script_windows) {
-            if (std::string const error = script_window.processScript(m_sample_timestamp); !error.empty()) {
-                logMessage(error);
+        {
+            ProfileScope profile(m_profiler, ProfileSection::Scripts);
+            for (ScriptWindow& script_window : m_script_windows) {
+                if (std::string const error = script_window.processScript(m_sample_timestamp); !error.empty()) {
+                    logMessage(error);
+                }
+            }
+        }
+        {
+            ProfileScope profile(m_profiler, ProfileSection::Sampling);
+            if (timestamps.size() == 1 && blocks.empty()) {
+                m_sampler.sample(m_sample_timestamp);
+                m_capture_engine.sample(m_sample_timestamp);
+            } else {
+                // Scripts and pause triggers run once per batch
+                m_sampler.sampleBatch(timestamps, blocks);
+                m_capture_engine.sampleBatch(timestamps, blocks);
             }
         }
-        m_sampler.sample(m_sample_timestamp);
 
         // Check pause triggers
+        ProfileScope profile(m_profiler, ProfileSection::PauseTriggers);
         for (PauseTrigger& trigger : m_pause_triggers) {
             bool pause_triggered = trigger.check();
             if (pause_triggered) {
@@ -343,18 +364,47 @@ void DbgGui::sampleWithTimestamp(double timestamp) {
         m_paused = true;
     }
 
-    // Wait in infinitely loop while paused
-    while (m_paused) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    // Wait while paused. Checked without the lock first so that running does
+    // not take a mutex on every sample.
+    bool was_paused = m_paused;
+    if (was_paused) {
         // Set sync time to 0 so that if speed is changed while paused, it will
         // be effective immediately. Otherwise simulation could run for e.g. 10ms
         // before new speed is taken into use
         m_next_sync_timestamp = 0;
+        m_sampling_pause.waitWhilePaused(isSamplingThread());
     }
 
+    // Background sampler keeps its own wall clock schedule
+    if (m_background_sampler) {
+        if (was_paused) {
+            m_background_sampler->restartSchedule();
+        }
+        return;
+    }
+    ProfileScope profile(m_profiler, ProfileSection::SpeedSync);
     synchronizeSpeed();
 }
 
+void DbgGui::startBackgroundSampling(double sampling_time) {
+    if (m_gui_thread.joinable() && std::this_thread::get_id() != m_gui_thread.get_id()) {
+        runOnGuiThreadAndWait([this, sampling_time] { startBackgroundSampling(sampling_time); });
+        return;
+    }
+    if (m_background_sampler) {
+        logMessage("Background sampling has already been started.");
+        return;
+    }
+    assert(sampling_time > 0);
+    m_sampling_time = sampling_time;
+    m_background_sampler = std::make_unique<BackgroundSampler>(
+      sampling_time,
+      [this](double timestamp) { sampleWithTimestamp(timestamp); },
+      m_sample_timestamp + sampling_time);
+    // Started only after the pointer is set because the callback checks it
+    m_background_sampler->start();
+}
+
 std::vector<CommandPaletteCommand> DbgGui::commandPaletteCommands(bool enable_sampling_hotkeys) {
     auto save_all_plots_as_csv = [&] {
         std::vector<Scalar*> scalars;
@@ -369,11 +419,11 @@ std::vector<CommandPaletteCommand> DbgGui::commandPaletteCommands(bool enable_sa
     std::function<void()> step_action;
     if (enable_sampling_hotkeys) {
         start_pause_action = [&] {
-            m_paused = !m_paused;
+            setPaused(!m_paused);
         };
         step_action = [&] {
             m_pause_at_time = std::numeric_limits<double>::epsilon();
-            m_paused = false;
+            setPaused(false);
         };
     }
 
@@ -426,6 +476,25 @@ void DbgGui::saveSettings() {
     }
 }
 
+void DbgGui::openHistoryFile() {
+    if (m_options.history_file.empty()) {
+        m_sampler.setHistoryFile(nullptr);
+        return;
+    }
+    std::string filename = m_options.history_file;
+    if (!filename.ends_with(HISTORY_FILE_EXTENSION)) {
+        filename += HISTORY_FILE_EXTENSION;
+    }
+    // Release the previous file first in case the same file is opened again
+    m_sampler.setHistoryFile(nullptr);
+    auto file = HistoryFile::create(filename, size_t(std::max(m_options.history_file_size, 2)));
+    if (!file) {
+        logMessage(file.error());
+        return;
+    }
+    m_sampler.setHistoryFile(std::move(*file));
+}
+
 void DbgGui::loadSettings() {
     const char* env = std::getenv(USER_SETTINGS_LOCATION);
     if (env == nullptr) {
@@ -440,6 +509,50 @@ void DbgGui::loadSettings() {
     }
 }
 
+// The sampling thread never takes a lock for committed samples so a slow
+// frame cannot stall the target while the rows are drained.
+void DbgGui::drainSamples() {
+    {
+        ProfileScope profile(m_profiler, ProfileSection::DrainSamples);
+        m_sampler.emptyTempBuffers();
+        for (std::unique_ptr<DbgGui_SamplingDomain> const& domain : m_sampling_domains) {
+            domain->sampler.emptyTempBuffers();
+        }
+    }
+    m_plot_timestamp = m_sampler.latestTime();
+    size_t dropped = m_sampler.takeDroppedSampleCount();
+    for (std::unique_ptr<DbgGui_SamplingDomain> const& domain : m_sampling_domains) {
+        m_plot_timestamp = std::max(m_plot_timestamp, domain->sampler.latestTime());
+        dropped += domain->sampler.takeDroppedSampleCount();
+    }
+    if (dropped > 0) {
+        logMessage(std::format("{} samples were dropped because the GUI could not keep up with sampling.", dropped));
+    }
+    if (std::optional<std::string> error = m_sampler.takeHistoryFileError()) {
+        logMessage(*error);
+    }
+    if (m_background_sampler) {
+        if (uint64_t missed = m_background_sampler->takeMissedDeadlineCount(); missed > 0) {
+            logMessage(std::format("{} sampling deadlines were missed by the background sampler.", missed));
+        }
+    }
+    if (!m_capture_engine.empty()) {
+        std::vector<Capture> captures;
+        {
+            std::scoped_lock lock(m_sampling_mutex);
+            captures = m_capture_engine.takeCaptures();
+        }
+        for (Capture& capture : captures) {
+            logMessage(std::format("Capture of {} triggered at t={}", capture.trigger_name, capture.trigger_time));
+            m_captures.push_back(std::move(capture));
+        }
+        if (m_captures.size() > MAX_CAPTURES) {
+            m_captures.erase(m_captures.begin(), m_captures.end() - MAX_CAPTURES);
+            m_selected_capture = -1;
+        }
+    }
+}
+
 void DbgGui::updateLoop() {
     //---------- Initializations ----------
     glfwSetErrorCallback(glfw_error_callback);
@@ -482,13 +595,20 @@ void DbgGui::updateLoop() {
         m_accepting_gui_operations = true;
     }
     m_initialized = true;
+    m_initialized.notify_all();
 
     //---------- Actual update loop ----------
     while (!glfwWindowShouldClose(m_window)) {
         glfwPollEvents();
+        ProfileScope frame_profile(m_profiler, ProfileSection::Frame);
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
         ImGui::NewFrame();
+        {
+            // Nothing that the preparation reads may change before it is done
+            ProfileScope profile(m_profiler, ProfileSection::PreparePlots);
+            m_plot_prefetch.wait();
+        }
         // Runtime additions must mutate signal containers on the GUI thread
         // before any window traverses them during this frame.
         processPendingGuiOperations();
@@ -510,30 +630,37 @@ void DbgGui::updateLoop() {
         addPopupModal(str::PAUSE_AT);
 
         //---------- Main windows ----------
-        {
-            std::scoped_lock<std::mutex> lock(m_sampling_mutex);
-            m_plot_timestamp = m_sample_timestamp;
-            m_sampler.emptyTempBuffers();
-        }
+        auto profiled = [this](ProfileSection section, void (DbgGui::*show)()) {
+            ProfileScope profile(m_profiler, section);
+            (this->*show)();
+        };
         showDockSpaces();
         showErrorModal();
-        showMainMenuBar();
-        showLogWindow();
-        showScalarWindow();
-        showVectorWindow();
-        showCustomWindow();
-        showSymbolsWindow();
-        showScriptWindow();
-        showGridWindow();
-        showScalarPlots();
-        showVectorPlots();
-        showSpectrumPlots();
+        profiled(ProfileSection::MainMenuBar, &DbgGui::showMainMenuBar);
+        profiled(ProfileSection::LogWindow, &DbgGui::showLogWindow);
+        profiled(ProfileSection::CaptureWindow, &DbgGui::showCaptureWindow);
+        profiled(ProfileSection::ScalarWindow, &DbgGui::showScalarWindow);
+        profiled(ProfileSection::VectorWindow, &DbgGui::showVectorWindow);
+        profiled(ProfileSection::CustomWindow, &DbgGui::showCustomWindow);
+        profiled(ProfileSection::SymbolsWindow, &DbgGui::showSymbolsWindow);
+        profiled(ProfileSection::ScriptWindow, &DbgGui::showScriptWindow);
+        profiled(ProfileSection::GridWindow, &DbgGui::showGridWindow);
+        profiled(ProfileSection::ScalarPlots, &DbgGui::showScalarPlots);
+        profiled(ProfileSection::VectorPlots, &DbgGui::showVectorPlots);
+        profiled(ProfileSection::SpectrumPlots, &DbgGui::showSpectrumPlots);
+        showPerformanceWindow();
         showCustomSignalCreator();
         setInitialFocus();
         updateSavedSettings();
 
         //---------- Rendering ----------
         ImGui::Render();
+        // The draw data has its own copy of the plotted values so the samples
+        // for the next frame are drained and its plots prepared in the
+        // background while this frame is rendered.
+        drainSamples();
+        preparePlots();
+        ProfileScope rendering_profile(m_profiler, ProfileSection::Rendering);
         int display_w, display_h;
         glfwGetFramebufferSize(m_window, &display_w, &display_h);
         glViewport(0, 0, display_w, display_h);
@@ -543,8 +670,12 @@ void DbgGui::updateLoop() {
         ImGui::UpdatePlatformWindows();
         ImGui::RenderPlatformWindowsDefault();
         glfwMakeContextCurrent(m_window);
+        // Waiting for vsync is not counted
+        rendering_profile.stop();
+        frame_profile.stop();
         glfwSwapBuffers(m_window);
     }
+    m_plot_prefetch.wait();
 
     stopPendingGuiOperations();
 
@@ -557,7 +688,7 @@ void DbgGui::updateLoop() {
     glfwDestroyWindow(m_window);
     glfwTerminate();
     m_window = nullptr;
-    m_paused = false;
+    setPaused(false);
 }
 
 std::shared_ptr<DbgGui::PendingGuiOperation> DbgGui::runOnGuiThread(std::function<void()> operation) {
@@ -678,6 +809,10 @@ void DbgGui::loadPreviousSessionSettings() {
         if (!once) {
             once = true;
             m_sampler.setBufferSize(m_options.sampling_buffer_size);
+            for (std::unique_ptr<DbgGui_SamplingDomain> const& domain : m_sampling_domains) {
+                domain->sampler.setBufferSize(m_options.sampling_buffer_size);
+            }
+            openHistoryFile();
             TRY(int xpos = std::max(0, int(m_settings["window"]["xpos"]));
                 int ypos = std::max(0, int(m_settings["window"]["ypos"]));
                 glfwSetWindowPos(m_window, xpos, ypos);)
@@ -775,7 +910,7 @@ void DbgGui::loadPreviousSessionSettings() {
                         forEachSignalId(subplot_data["signals"], [&](uint64_t id) {
                             Scalar* scalar = findScalar(m_scalars, id);
                             if (scalar) {
-                                m_sampler.startSampling(scalar);
+                                sampler(scalar).startSampling(scalar);
                                 plot.addScalarToPlot(scalar, subplot_idx);
                             }
                         });
@@ -786,7 +921,7 @@ void DbgGui::loadPreviousSessionSettings() {
                 forEachSignalId(scalar_plot_data["signals"], [&](uint64_t id) {
                     Scalar* scalar = findScalar(m_scalars, id);
                     if (scalar) {
-                        m_sampler.startSampling(scalar);
+                        sampler(scalar).startSampling(scalar);
                         plot.addScalarToPlot(scalar);
                     }
                 });
@@ -799,7 +934,7 @@ void DbgGui::loadPreviousSessionSettings() {
             forEachSignalId(vector_plot_data["signals"], [&](uint64_t id) {
                 Vector2D* vec = findVector(m_vectors, id);
                 if (vec) {
-                    m_sampler.startSampling(vec);
+                    startSampling(vec);
                     plot.addVectorToPlot(vec);
                 }
             });
@@ -814,14 +949,14 @@ void DbgGui::loadPreviousSessionSettings() {
                         Scalar* real = findScalar(m_scalars, xy[0]);
                         Scalar* imag = findScalar(m_scalars, xy[1]);
                         if (real && imag) {
-                            m_sampler.startSampling(real);
-                            m_sampler.startSampling(imag);
+                            sampler(real).startSampling(real);
+                            sampler(imag).startSampling(imag);
                             plot.addToPlot(real, imag);
                             // An imaginary ID of 0 marks a real-only spectrum. If a
                             // nonzero imaginary ID is unresolved, wait for its
                             // scalar to be registered instead of changing the type.
                         } else if (real && xy[1] == 0) {
-                            m_sampler.startSampling(real);
+                            sampler(real).startSampling(real);
                             plot.addToPlot(real, nullptr);
                         }
                     }
@@ -834,6 +969,7 @@ void DbgGui::loadPreviousSessionSettings() {
             Scalar* scalar = findScalar(m_scalars, id);
             if (scalar) {
                 scalar->fromJson(scalar_data);
+                setSampleDivider(scalar, std::max(scalar_data.value("sample_divider", 1u), 1u));
             };
         }
 
@@ -1189,8 +1325,7 @@ void DbgGui::updateSavedSettings() {
         }
 
         if (scalar->deleted) {
-            std::scoped_lock<std::mutex> lock(m_sampling_mutex);
-            m_sampler.stopSampling(scalar.get());
+            sampler(scalar.get()).stopSampling(scalar.get());
             remove(m_selected_scalars, scalar.get());
             bool const has_live_duplicate = std::any_of(m_scalars.begin(), m_scalars.end(), [&](auto const& candidate) {
                 return candidate.get() != scalar.get()
@@ -1342,27 +1477,40 @@ void DbgGui::close() {
     m_closing = true;
     stopPendingGuiOperations();
     if (m_window && m_options.pause_on_close) {
-        m_paused = true;
-        while (m_paused) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
-        }
+        pause();
     }
 
     if (m_window) {
         glfwSetWindowShouldClose(m_window, 1);
     }
-    m_paused = false;
+    setPaused(false);
     if (m_gui_thread.joinable()) {
         m_gui_thread.join();
     }
+    // Stopped after the GUI so that the sampler is not left waiting for the
+    // GUI to resume
+    if (m_background_sampler) {
+        m_background_sampler->stop();
+        m_background_sampler = nullptr;
+    }
 }
 
 void DbgGui::pause() {
-    m_paused = true;
     m_next_sync_timestamp = 0;
-    while (m_paused) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    }
+    m_sampling_pause.pause(isSamplingThread());
+}
+
+bool DbgGui::isSamplingThread() const {
+    return !m_background_sampler || m_background_sampler->isSamplingThread();
+}
+
+void DbgGui::setPaused(bool paused) {
+    m_sampling_pause.setPaused(paused);
+}
+
+bool DbgGui::pauseSampling() {
+    ProfileScope profile(m_profiler, ProfileSection::PauseWait);
+    return m_sampling_pause.pauseSampling();
 }
 
 Scalar* DbgGui::addSymbol(std::string const& symbol_name, std::string group, std::string const& alias, double scale, double offset) {
@@ -1405,6 +1553,95 @@ Scalar* DbgGui::addScalar(ValueSource const& src, std::string group, std::string
                                std::format("{:g}", offset));
 }
 
+void DbgGui::setSampleDivider(Scalar* scalar, uint32_t divider) {
+    if (scalar->sample_divider == divider) {
+        return;
+    }
+    scalar->sample_divider = divider;
+    // Samples taken at the old rate are not kept
+    if (sampler(scalar).isScalarSampled(scalar)) {
+        sampler(scalar).stopSampling(scalar);
+        sampler(scalar).startSampling(scalar);
+    }
+}
+
+ScrollingBuffer& DbgGui::sampler(Scalar const* scalar) {
+    return domainSampler(scalar, m_sampler);
+}
+
+void DbgGui::startSampling(Vector2D* vector) {
+    sampler(vector->x).startSampling(vector->x);
+    sampler(vector->y).startSampling(vector->y);
+}
+
+DbgGui_SamplingDomain* DbgGui::addSamplingDomain(std::string const& name) {
+    if (m_gui_thread.joinable() && std::this_thread::get_id() != m_gui_thread.get_id()) {
+        DbgGui_SamplingDomain* result = nullptr;
+        runOnGuiThreadAndWait([this, &result, &name] { result = addSamplingDomain(name); });
+        return result;
+    }
+    for (std::unique_ptr<DbgGui_SamplingDomain> const& domain : m_sampling_domains) {
+        if (domain->name == name) {
+            return domain.get();
+        }
+    }
+    return m_sampling_domains.emplace_back(new DbgGui_SamplingDomain{name, ScrollingBuffer(m_options.sampling_buffer_size)}).get();
+}
+
+void DbgGui::setSamplingDomain(Scalar* scalar, DbgGui_SamplingDomain* domain) {
+    ::setSamplingDomain(scalar, domain, m_sampler, m_vectors);
+}
+
+void DbgGui::setSamplingDomainAsync(std::string group, std::string name, DbgGui_SamplingDomain* domain) {
+    runOnGuiThread([this, group = std::move(group), name = std::move(name), domain] {
+        if (Scalar* scalar = findScalar(m_scalars, signalId(name, group.empty() ? "debug" : group))) {
+            setSamplingDomain(scalar, domain);
+        }
+    });
+}
+
+void DbgGui::sampleDomain(DbgGui_SamplingDomain& domain, double timestamp) {
+    if (isClosed()) {
+        return;
+    }
+    // Domains pause together with the main sampling
+    m_sampling_pause.sampleDomain([&] {
+        if (timestamp < domain.sample_timestamp) {
+            domain.sampler.shiftTime(timestamp - domain.sample_timestamp);
+        }
+        domain.sample_timestamp = timestamp;
+        domain.sampler.sample(timestamp);
+    });
+}
+
+double DbgGui::wallClockTime() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_wall_clock_start).count();
+}
+
+void DbgGui::armCapture(Scalar* trigger, double level) {
+    // Selected scalars are captured together with the trigger
+    std::vector<CaptureSignal> signals{{trigger->alias_and_group, trigger->src, trigger->getScale(), trigger->getOffset()}};
+    if (contains(m_selected_scalars, trigger)) {
+        for (Scalar* scalar : m_selected_scalars) {
+            if (scalar != trigger) {
+                signals.push_back({scalar->alias_and_group, scalar->src, scalar->getScale(), scalar->getOffset()});
+            }
+        }
+    }
+    CaptureSettings settings = m_capture_settings;
+    settings.level = level;
+    std::scoped_lock lock(m_sampling_mutex);
+    m_capture_engine.arm(std::move(signals), settings);
+}
+
+void DbgGui::setSampleDividerAsync(std::string group, std::string name, uint32_t divider) {
+    runOnGuiThread([this, group = std::move(group), name = std::move(name), divider] {
+        if (Scalar* scalar = findScalar(m_scalars, signalId(name, group.empty() ? "debug" : group))) {
+            setSampleDivider(scalar, std::max(divider, 1u));
+        }
+    });
+}
+
 void DbgGui::addScalarAsync(ValueSource src, std::string group, std::string name, double scale, double offset) {
     runOnGuiThread([this,
                     src = std::move(src),
@@ -1447,7 +1684,7 @@ Scalar* DbgGui::addScalarExpression(ValueSource const& src,
                                                                              m_scalars,
                                                                              m_custom_windows);
         for (Scalar* scalar_to_sample : scalars_to_sample) {
-            m_sampler.startSampling(scalar_to_sample);
+            sampler(scalar_to_sample).startSampling(scalar_to_sample);
         }
     }
     std::vector<std::string> groups = str::split(new_scalar->group, '|');
@@ -1551,7 +1788,7 @@ Vector2D* DbgGui::addVector(ValueSource const& x, ValueSource const& y, std::str
     std::sort(added_group->signals.begin(), added_group->signals.end(), [](Vector2D* a, Vector2D* b) { return a->name < b->name; });
     if (m_initialized.load()
         && restoreVectorSettings(new_vector.get(), m_settings, m_vector_plots)) {
-        m_sampler.startSampling(new_vector.get());
+        startSampling(new_vector.get());
     }
     return new_vector.get();
 }
@@ -1572,6 +1809,8 @@ Vector2D* DbgGui::addVectorFromScalars(Scalar* x, Scalar* y) {
     new_vector->id = id;
     new_vector->x = x;
     new_vector->y = y;
+    // Both components are sampled in the domain of x
+    setSamplingDomain(y, x->sampling_domain);
     std::vector<std::string> groups = str::split(new_vector->group, '|');
     SignalGroup<Vector2D>* added_group = &m_vector_groups[groups[0]];
     added_group->name = groups[0];
@@ -1587,7 +1826,7 @@ Vector2D* DbgGui::addVectorFromScalars(Scalar* x, Scalar* y) {
     std::sort(added_group->signals.begin(), added_group->signals.end(), [](Vector2D* a, Vector2D* b) { return a->name < b->name; });
     if (m_initialized.load()
         && restoreVectorSettings(new_vector.get(), m_settings, m_vector_plots)) {
-        m_sampler.startSampling(new_vector.get());
+        startSampling(new_vector.get());
     }
     // Reuse vector_symbols persistence intentionally. This restores only
     // symbol-backed scalar pairs; vectors built from custom scalars are session-only.
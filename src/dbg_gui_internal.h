@@ -22,16 +22,26 @@
 
 #pragma once
 
+#include "background_sampler.h"
 #include "symbols/dbg_symbols.hpp"
 #include "symbols/variant_symbol.h"
 #include "scrolling_buffer.h"
 #include "sample_clipboard.h"
+#include "sampling_domain.h"
+#include "sampling_pause.h"
 #include "imgui.h"
 #include "imgui_helpers.h"
+#include "pacing_clock.h"
+#include "plot_prefetch.h"
+#include "profiler.h"
 #include "nlohmann/json.hpp"
 #include "themes.h"
 #include "str_helpers.h"
+#include "triggered_capture.h"
+#include "worker_pool.h"
 
+#include <chrono>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -81,10 +91,26 @@ class DbgGui {
 
     void sample();
     void sampleWithTimestamp(double timestamp);
+    void sampleBatch(std::span<double const> timestamps, std::span<DbgGui_SampleBlock const> blocks);
+    // Samples on a background thread every sampling_time seconds of wall clock
+    // time until the GUI is closed. The application must not sample itself.
+    void startBackgroundSampling(double sampling_time);
+    DbgGui_PacingStatistics pacingStatistics();
+    void setProfilingEnabled(bool enabled);
+    std::vector<DbgGui_ProfileSection> profile();
 
     bool isClosed();
     void close();
+    // Pauses and waits until resumed from the GUI
     void pause();
+    // Wakes up the threads waiting for the paused state to change
+    void setPaused(bool paused);
+    // Pauses and waits until the main and domain sampling threads have stopped
+    // so that sampled data and symbols can be accessed. Returns the previous paused state to
+    // be restored with setPaused().
+    bool pauseSampling();
+    // False on other threads than the background sampler when it is running
+    bool isSamplingThread() const;
 
     Scalar* addSymbol(std::string const& symbol_name,
                       std::string group,
@@ -101,6 +127,14 @@ class DbgGui {
                         std::string name,
                         double scale = 1.0,
                         double offset = 0.0);
+    void setSampleDivider(Scalar* scalar, uint32_t divider);
+    void setSampleDividerAsync(std::string group, std::string name, uint32_t divider);
+    void armCapture(Scalar* trigger, double level);
+    DbgGui_SamplingDomain* addSamplingDomain(std::string const& name);
+    void setSamplingDomain(Scalar* scalar, DbgGui_SamplingDomain* domain);
+    void setSamplingDomainAsync(std::string group, std::string name, DbgGui_SamplingDomain* domain);
+    void sampleDomain(DbgGui_SamplingDomain& domain, double timestamp);
+    double wallClockTime() const;
     Vector2D* addVector(ValueSource const& x,
                         ValueSource const& y,
                         std::string group,
@@ -122,6 +156,12 @@ class DbgGui {
     void showErrorModal();
     void showMainMenuBar();
     void showLogWindow();
+    void showCaptureWindow();
+    // Buffer of the sampling domain of the signal
+    ScrollingBuffer& sampler(Scalar const* scalar);
+    // Starts sampling both components in their sampling domain
+    void startSampling(Vector2D* vector);
+    void showPerformanceWindow();
     void showScalarWindow();
     void showSymbolsWindow();
     void showVectorWindow();
@@ -140,6 +180,8 @@ class DbgGui {
     std::vector<CommandPaletteCommand> commandPaletteCommands(bool enable_sampling_hotkeys = true);
     std::string commandHotkeyName(std::string_view command_id, ImGuiKeyChord default_hotkey) const;
     void addCustomWindowDragAndDrop(CustomWindow& custom_window);
+    void drainSamples();
+    void preparePlots();
     void showScalarPlots();
     void showVectorPlots();
     void showSpectrumPlots();
@@ -148,6 +190,7 @@ class DbgGui {
     void updateSavedSettings();
     void saveSettings();
     void loadSettings();
+    void openHistoryFile();
     void setInitialFocus();
     void synchronizeSpeed();
     void copyAllScalarSamplesToClipboard();
@@ -217,6 +260,9 @@ class DbgGui {
     bool m_show_custom_signal_creator = false;
 
     ScrollingBuffer m_sampler{int(1e6)};
+    // Domains are never removed so that sampling threads can keep their pointers
+    std::vector<std::unique_ptr<DbgGui_SamplingDomain>> m_sampling_domains;
+    std::chrono::steady_clock::time_point m_wall_clock_start = std::chrono::steady_clock::now();
     std::vector<std::unique_ptr<Scalar>> m_scalars;
     std::map<std::string, SignalGroup<Scalar>> m_scalar_groups;
     std::vector<std::unique_ptr<Vector2D>> m_vectors;
@@ -233,6 +279,12 @@ class DbgGui {
     std::vector<SpectrumPlot> m_spectrum_plots;
     std::vector<DockSpace> m_dockspaces;
     std::vector<PauseTrigger> m_pause_triggers;
+    // Guarded by m_sampling_mutex
+    CaptureEngine m_capture_engine;
+    // Settings for newly armed captures
+    CaptureSettings m_capture_settings;
+    std::vector<Capture> m_captures;
+    int m_selected_capture = -1;
     struct {
         Focus scalars;
         Focus vectors;
@@ -243,10 +295,16 @@ class DbgGui {
     double m_sampling_time;
     double m_plot_timestamp = 0;
     double m_sample_timestamp = 0;
+    WorkerPool m_worker_pool;
+    PlotPrefetch m_plot_prefetch;
     std::atomic<double> m_next_sync_timestamp = 0;
+    PacingClock m_pacing_clock;
+    Profiler m_profiler;
+    bool m_show_performance_window = false;
 
     std::atomic<bool> m_initialized = false;
     std::atomic<bool> m_paused = true;
+    SamplingPause m_sampling_pause{m_paused};
     std::atomic<bool> m_closing = false;
     bool m_initial_focus_set = false;
     float m_simulation_speed = 1;
@@ -265,7 +323,10 @@ class DbgGui {
         bool show_vertical_line_in_all_plots = true;
         Theme theme = Theme::DefaultDark;
         int sampling_buffer_size = (int)1e6;
+        std::string history_file;
+        int history_file_size = (int)1e5;
         int font_size = 13;
+        int sync_interval_ms = 10;
         double m_linked_scalar_x_axis_range = 1;
         double spectrum_plot_threshold = 0;
 
@@ -277,7 +338,10 @@ class DbgGui {
             j["show_latest_message_on_main_menu_bar"] = show_latest_message_on_main_menu_bar;
             j["theme"] = theme;
             j["sampling_buffer_size"] = sampling_buffer_size;
+            j["history_file"] = history_file;
+            j["history_file_size"] = history_file_size;
             j["font_size"] = font_size;
+            j["sync_interval_ms"] = sync_interval_ms;
             j["linked_scalar_x_axis_range"] = m_linked_scalar_x_axis_range;
             j["show_vertical_line_in_all_plots"] = show_vertical_line_in_all_plots;
             j["spectrum_plot_threshold"] = spectrum_plot_threshold;
@@ -291,7 +355,10 @@ class DbgGui {
             show_latest_message_on_main_menu_bar = j.value("show_latest_message_on_main_menu_bar", show_latest_message_on_main_menu_bar);
             theme = j.value("theme", theme);
             sampling_buffer_size = j.value("sampling_buffer_size", sampling_buffer_size);
+            history_file = j.value("history_file", history_file);
+            history_file_size = j.value("history_file_size", history_file_size);
             font_size = j.value("font_size", font_size);
+            sync_interval_ms = j.value("sync_interval_ms", sync_interval_ms);
             m_linked_scalar_x_axis_range = j.value("linked_scalar_x_axis_range", m_linked_scalar_x_axis_range);
             show_vertical_line_in_all_plots = j.value("show_vertical_line_in_all_plots", show_vertical_line_in_all_plots);
             spectrum_plot_threshold = j.value("spectrum_plot_threshold", spectrum_plot_threshold);
@@ -299,6 +366,7 @@ class DbgGui {
     } m_options;
 
     std::jthread m_gui_thread;
+    std::unique_ptr<BackgroundSampler> m_background_sampler;
     std::mutex m_sampling_mutex;
     struct PendingGuiOperation {
         std::function<void()> operation;
@@ -61,6 +61,75 @@ void addScalarAliasInput(Scalar& scalar) {
     }
 }
 
+// Decimates the scalar plots in parallel for the range and size that they had
+// in the previous frame, which is what they will most likely ask for.
+void DbgGui::preparePlots() {
+    bool running = !m_paused;
+    for (ScalarPlot& scalar_plot : m_scalar_plots) {
+        if (!scalar_plot.open || !scalar_plot.focus.focused) {
+            continue;
+        }
+        // Same x-axis as in showScalarPlots()
+        MinMax x_limits = m_options.link_scalar_x_axis ? m_linked_scalar_x_axis_limits : scalar_plot.x_axis;
+        double x_range = m_options.link_scalar_x_axis ? m_options.m_linked_scalar_x_axis_range : scalar_plot.x_range;
+        if (running || scalar_plot.last_frame_timestamp < m_plot_timestamp) {
+            x_limits = {m_plot_timestamp - x_range, m_plot_timestamp};
+        }
+        for (ScalarPlot::Subplot const& subplot : scalar_plot.subplots) {
+            if (subplot.point_count <= 0) {
+                continue;
+            }
+            for (Scalar* scalar : subplot.scalars) {
+                ScrollingBuffer& scalar_sampler = sampler(scalar);
+                double scale = scalar->getScale();
+                double offset = scalar->getOffset();
+                int point_count = subplot.point_count;
+                m_plot_prefetch.add({.plot = &subplot,
+                                     .signal = scalar,
+                                     .start = x_limits.min,
+                                     .end = x_limits.max,
+                                     .count = point_count,
+                                     .transform = {.y_scale = scale, .y_offset = offset}},
+                                    [=, &scalar_sampler]() {
+                                        return scalar_sampler.getValuesInTimeRange(scalar, x_limits.min, x_limits.max, point_count, scale, offset);
+                                    });
+            }
+        }
+    }
+    // Samples of the spectrums that are calculated next
+    for (SpectrumPlot& plot : m_spectrum_plots) {
+        if (!plot.open || !plot.focus.focused) {
+            continue;
+        }
+        double start = m_plot_timestamp - plot.time_range;
+        double end = m_plot_timestamp;
+        for (auto& spec : plot.spectrums) {
+            if (spec.calculation.valid()) {
+                continue;
+            }
+            ScrollingBuffer& spec_sampler = sampler(spec.real);
+            for (Scalar* scalar : {spec.real, spec.imag}) {
+                if (scalar == nullptr) {
+                    continue;
+                }
+                ScrollingBuffer& scalar_sampler = sampler(scalar);
+                double scale = scalar->getScale();
+                double offset = scalar->getOffset();
+                m_plot_prefetch.add({.plot = &spec,
+                                     .signal = scalar,
+                                     .start = start,
+                                     .end = end,
+                                     .count = ALL_SAMPLES,
+                                     .transform = {.y_scale = scale, .y_offset = offset}},
+                                    [=, &spec_sampler, &scalar_sampler]() {
+                                        return scalar_sampler.getValuesInRange(scalar, spec_sampler.getTimeIndices(start, end), ALL_SAMPLES, scale, offset);
+                                    });
+            }
+        }
+    }
+    m_plot_prefetch.start(m_worker_pool);
+}
+
 void DbgGui::showScalarPlots() {
     // Show vertical line at same time in all plots if mouse is hovered in any plot
     static double vertical_line_time_next = 0;
@@ -193,15 +262,19 @@ void DbgGui::showScalarPlots() {
             ImPlot::SetupAxis(ImAxis_Y1, NULL, y_flags);
             x_range = MAX(1e-6, x_range);
 
-            auto time_idx = m_sampler.getTimeIndices(x_limits.min, x_limits.max);
             int point_count = int(2.0f * ImPlot::GetPlotSize().x);
+            subplot.point_count = point_count;
             std::unordered_map<Scalar*, bool> scalar_visible;
             for (Scalar* scalar : subplot.scalars) {
-                DecimatedValues values = m_sampler.getValuesInRange(scalar,
-                                                                    time_idx,
-                                                                    point_count,
-                                                                    scalar->getScale(),
-                                                                    scalar->getOffset());
+                PlotPrefetch::Request request{.plot = &subplot,
+                                              .signal = scalar,
+                                              .start = x_limits.min,
+                                              .end = x_limits.max,
+                                              .count = point_count,
+                                              .transform = {.y_scale = scalar->getScale(), .y_offset = scalar->getOffset()}};
+                DecimatedValues values = m_plot_prefetch.take(request, [&]() {
+                    return sampler(scalar).getValuesInTimeRange(scalar, x_limits.min, x_limits.max, point_count, scalar->getScale(), scalar->getOffset());
+                });
                 std::string label_id = std::format("{}###{}", scalar->alias_and_group, scalar->name_and_group);
                 bool visible = ImPlot::PlotLine(label_id.c_str(),
                                                 values.x.data(),
@@ -241,6 +314,11 @@ void DbgGui::showScalarPlots() {
                         m_pause_triggers.push_back(PauseTrigger(scalar, current_value));
                         ImGui::CloseCurrentPopup();
                     }
+                    double capture_level = scalar->getScaledValue();
+                    if (ImGui::InputDouble("Capture trigger level", &capture_level, 0, 0, "%g", ImGuiInputTextFlags_EnterReturnsTrue)) {
+                        armCapture(scalar, capture_level);
+                        ImGui::CloseCurrentPopup();
+                    }
                     if (ImGui::Button("Copy name")) {
                         ImGui::SetClipboardText(scalar->name.c_str());
                         ImGui::CloseCurrentPopup();
@@ -286,7 +364,7 @@ void DbgGui::showScalarPlots() {
                     for (uint64_t id : ids) {
                         Scalar* scalar = findScalar(m_scalars, id);
                         if (scalar) {
-                            m_sampler.startSampling(scalar);
+                            sampler(scalar).startSampling(scalar);
                             scalar_plot.addScalarToPlot(scalar, subplot_idx);
                         }
                     }
@@ -296,7 +374,7 @@ void DbgGui::showScalarPlots() {
                                                       payload->DataSize / sizeof(VariantSymbol*));
                     for (VariantSymbol* symbol : symbols) {
                         Scalar* scalar = addScalarSymbol(symbol, m_group_to_add_symbols);
-                        m_sampler.startSampling(scalar);
+                        sampler(scalar).startSampling(scalar);
                         scalar_plot.addScalarToPlot(scalar, subplot_idx);
                     }
                 }
@@ -323,14 +401,15 @@ void DbgGui::showScalarPlots() {
 
                 // Add small point to the sample location
                 std::vector<DecimatedValues> scalar_values_in_tooltip;
-                auto mouse_time_idx = m_sampler.getTimeIndices(mouse.x, mouse.x);
                 for (Scalar* scalar : subplot.scalars) {
+                    ScrollingBuffer& scalar_sampler = sampler(scalar);
+                    auto mouse_time_idx = scalar_sampler.getTimeIndices(mouse.x, mouse.x);
                     DecimatedValues& value = scalar_values_in_tooltip.emplace_back(
-                      m_sampler.getValuesInRange(scalar,
-                                                 mouse_time_idx,
-                                                 1,
-                                                 scalar->getScale(),
-                                                 scalar->getOffset()));
+                      scalar_sampler.getValuesInRange(scalar,
+                                                      mouse_time_idx,
+                                                      1,
+                                                      scalar->getScale(),
+                                                      scalar->getOffset()));
                     if (scalar_visible[scalar]) {
                         ImPlot::PushStyleColor(ImPlotCol_Line, scalar->color);
                         ImPlot::SetNextMarkerStyle(ImPlotMarker_Circle, 3);
@@ -356,18 +435,14 @@ void DbgGui::showScalarPlots() {
                         if (std::isfinite(source_value)) {
                             std::pair<Scalar*, double> scalar_and_value{scalar, source_value};
                             if (!enum_str_cache.contains(scalar_and_value)) {
-                                bool paused = m_paused;
-                                m_paused = true;
-                                // Wait until main thread goes to pause state
-                                while (m_next_sync_timestamp > 0) {
-                                }
+                                bool paused = pauseSampling();
                                 double current_value = getSourceValue(scalar->src);
                                 // Temporarily write the unscaled sample value to retrieve its enum name.
                                 setSourceValue(scalar->src, source_value);
                                 enum_str_cache[scalar_and_value] = getSourceValueStr(scalar->src);
                                 // Write the original value back
                                 setSourceValue(scalar->src, current_value);
-                                m_paused = paused;
+                                setPaused(paused);
                             }
                             std::string const& enum_str = enum_str_cache[scalar_and_value];
                             if (!enum_str.empty()) {
@@ -388,6 +463,24 @@ void DbgGui::showScalarPlots() {
                 ImPlot::PopStyleColor(1);
             }
 
+            // Mark where the time jumped backwards, e.g. after loading a snapshot.
+            // Each sampling domain has its own time axis.
+            std::vector<double> time_jumps;
+            std::vector<ScrollingBuffer*> jump_samplers;
+            for (Scalar* scalar : subplot.scalars) {
+                ScrollingBuffer* scalar_sampler = &sampler(scalar);
+                if (std::ranges::find(jump_samplers, scalar_sampler) == jump_samplers.end()) {
+                    jump_samplers.push_back(scalar_sampler);
+                    std::vector<double> jumps = scalar_sampler->getDiscontinuities(x_limits.min, x_limits.max);
+                    time_jumps.insert(time_jumps.end(), jumps.begin(), jumps.end());
+                }
+            }
+            if (!time_jumps.empty()) {
+                ImPlot::PushStyleColor(ImPlotCol_Line, ImVec4(0.9f, 0.3f, 0.3f, 0.5f));
+                ImPlot::PlotInfLines("##Time jumps", time_jumps.data(), int(time_jumps.size()));
+                ImPlot::PopStyleColor(1);
+            }
+
             ImPlot::EndPlot();
         };
         if (scalar_plot.subplotCount() == 1) {
@@ -466,13 +559,25 @@ void DbgGui::showVectorPlots() {
             // Use time range from the scalar plots
             double last_sample_time = m_linked_scalar_x_axis_limits.max;
             double first_sample_time = MAX(last_sample_time - vector_plot.time_range, m_linked_scalar_x_axis_limits.min);
-            auto time_idx = m_sampler.getTimeIndices(first_sample_time, last_sample_time);
+            // Both components are in the same sampling domain but each is read
+            // from the buffer of its own domain
+            auto component_samples = [&](Scalar* scalar, bool scaled) {
+                ScrollingBuffer& component_sampler = sampler(scalar);
+                return component_sampler.getValuesInRange(scalar,
+                                                          component_sampler.getTimeIndices(first_sample_time, last_sample_time),
+                                                          ALL_SAMPLES,
+                                                          scaled ? scalar->getScale() : 1,
+                                                          scaled ? scalar->getOffset() : 0);
+            };
 
             // Collect rotation vectors to rotate samples to reference frame
             std::vector<XY<double>> frame_rotation_vectors;
+            DbgGui_SamplingDomain* reference_frame_domain = nullptr;
             if (vector_plot.reference_frame_vector) {
-                DecimatedValues values_x = m_sampler.getValuesInRange(vector_plot.reference_frame_vector->x, time_idx, ALL_SAMPLES);
-                DecimatedValues values_y = m_sampler.getValuesInRange(vector_plot.reference_frame_vector->y, time_idx, ALL_SAMPLES);
+                Vector2D* reference = vector_plot.reference_frame_vector;
+                reference_frame_domain = reference->x->sampling_domain;
+                DecimatedValues values_x = component_samples(reference->x, false);
+                DecimatedValues values_y = component_samples(reference->y, false);
                 frame_rotation_vectors.reserve(values_x.x.size());
                 for (size_t i = 0; i < values_x.y_max.size(); ++i) {
                     double angle = -atan2(values_y.y_min[i], values_x.y_min[i]);
@@ -482,18 +587,10 @@ void DbgGui::showVectorPlots() {
 
             // Plot vectors
             for (Vector2D* vector : vector_plot.vectors) {
-                DecimatedValues values_x = m_sampler.getValuesInRange(vector->x,
-                                                                      time_idx,
-                                                                      ALL_SAMPLES,
-                                                                      vector->x->getScale(),
-                                                                      vector->x->getOffset());
-                DecimatedValues values_y = m_sampler.getValuesInRange(vector->y,
-                                                                      time_idx,
-                                                                      ALL_SAMPLES,
-                                                                      vector->y->getScale(),
-                                                                      vector->y->getOffset());
-                // Rotate samples
-                if (frame_rotation_vectors.size() > 0) {
+                DecimatedValues values_x = component_samples(vector->x, true);
+                DecimatedValues values_y = component_samples(vector->y, true);
+                // Rotate samples. Samples from another domain do not line up with the reference frame.
+                if (frame_rotation_vectors.size() > 0 && vector->x->sampling_domain == reference_frame_domain) {
                     for (size_t i = 0; i < values_x.y_max.size(); ++i) {
                         double x_temp = values_x.y_min[i];
                         double y_temp = values_y.y_min[i];
@@ -553,7 +650,7 @@ void DbgGui::showVectorPlots() {
                     uint64_t id = *(uint64_t*)payload->Data;
                     Vector2D* vector = findVector(m_vectors, id);
                     if (vector) {
-                        m_sampler.startSampling(vector);
+                        startSampling(vector);
                         vector_plot.addVectorToPlot(vector);
                     }
                 }
@@ -564,7 +661,7 @@ void DbgGui::showVectorPlots() {
                         logMessage("Vector plots require exactly two symbols.");
                     } else {
                         Vector2D* vector = addVectorSymbol(symbols[0], symbols[1], m_group_to_add_symbols);
-                        m_sampler.startSampling(vector);
+                        startSampling(vector);
                         vector_plot.addVectorToPlot(vector);
                     }
                 }
@@ -577,7 +674,7 @@ void DbgGui::showVectorPlots() {
                         if (x && y) {
                             Vector2D* vector = addVectorFromScalars(x, y);
                             if (vector) {
-                                m_sampler.startSampling(vector);
+                                startSampling(vector);
                                 vector_plot.addVectorToPlot(vector);
                             }
                         }
@@ -676,7 +773,7 @@ void DbgGui::showSpectrumPlots() {
                     for (uint64_t id : ids) {
                         Scalar* scalar = findScalar(m_scalars, id);
                         if (scalar) {
-                            m_sampler.startSampling(scalar);
+                            sampler(scalar).startSampling(scalar);
                             plot.addToPlot(scalar, nullptr);
                         }
                     }
@@ -686,7 +783,7 @@ void DbgGui::showSpectrumPlots() {
                                                       payload->DataSize / sizeof(VariantSymbol*));
                     for (VariantSymbol* symbol : symbols) {
                         Scalar* scalar = addScalarSymbol(symbol, m_group_to_add_symbols);
-                        m_sampler.startSampling(scalar);
+                        sampler(scalar).startSampling(scalar);
                         plot.addToPlot(scalar, nullptr);
                     }
                 }
@@ -694,7 +791,7 @@ void DbgGui::showSpectrumPlots() {
                     uint64_t id = *(uint64_t*)payload->Data;
                     Vector2D* vector = findVector(m_vectors, id);
                     if (vector) {
-                        m_sampler.startSampling(vector);
+                        startSampling(vector);
                         plot.addToPlot(vector->x, vector->y);
                     }
                 }
@@ -722,22 +819,29 @@ void DbgGui::showSpectrumPlots() {
         }
         ImPlot::PopStyleVar();
 
+        double start = m_plot_timestamp - plot.time_range;
         for (auto& spec : plot.spectrums) {
             bool one_sided = spec.imag == nullptr;
-            auto time_idx = m_sampler.getTimeIndices(m_plot_timestamp - plot.time_range, m_plot_timestamp);
+            ScrollingBuffer& spec_sampler = sampler(spec.real);
+            auto time_idx = spec_sampler.getTimeIndices(start, m_plot_timestamp);
+            auto spectrum_samples = [&](Scalar* scalar) {
+                double scale = scalar->getScale();
+                double offset = scalar->getOffset();
+                return m_plot_prefetch.take({.plot = &spec,
+                                             .signal = scalar,
+                                             .start = start,
+                                             .end = m_plot_timestamp,
+                                             .count = ALL_SAMPLES,
+                                             .transform = {.y_scale = scale, .y_offset = offset}},
+                                            [&]() {
+                                                return sampler(scalar).getValuesInRange(scalar, time_idx, ALL_SAMPLES, scale, offset);
+                                            });
+            };
             if (spec.calculation.valid() && spec.calculation.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
                 spec.data = spec.calculation.get();
             } else if (!one_sided && !spec.calculation.valid()) {
-                DecimatedValues samples_x = m_sampler.getValuesInRange(spec.real,
-                                                                       time_idx,
-                                                                       ALL_SAMPLES,
-                                                                       spec.real->getScale(),
-                                                                       spec.real->getOffset());
-                DecimatedValues samples_y = m_sampler.getValuesInRange(spec.imag,
-                                                                       time_idx,
-                                                                       ALL_SAMPLES,
-                                                                       spec.imag->getScale(),
-                                                                       spec.imag->getOffset());
+                DecimatedValues samples_x = spectrum_samples(spec.real);
+                DecimatedValues samples_y = spectrum_samples(spec.imag);
                 std::vector<std::complex<double>> samples = collectFftSamples(samples_x.x,
                                                                               samples_x.y_min,
                                                                               samples_y.y_min,
@@ -750,11 +854,7 @@ void DbgGui::showSpectrumPlots() {
                                               one_sided,
                                               m_options.spectrum_plot_threshold / 100.0);
             } else if (one_sided && !spec.calculation.valid()) {
-                DecimatedValues values = m_sampler.getValuesInRange(spec.real,
-                                                                    time_idx,
-                                                                    ALL_SAMPLES,
-                                                                    spec.real->getScale(),
-                                                                    spec.real->getOffset());
+                DecimatedValues values = spectrum_samples(spec.real);
                 std::vector<double> zeros(values.x.size(), 0);
                 std::vector<std::complex<double>> samples = collectFftSamples(values.x,
                                                                               values.y_min,
@@ -779,21 +879,21 @@ SampleClipboardData DbgGui::collectScalarSamples(std::vector<Scalar*> const& sca
 
     // Pause while collecting samples because export can take a long time and the sampling
     // buffers would get filled and start hogging a lot of memory
-    bool paused = m_paused;
-    m_paused = true;
-    // Wait until main thread goes to pause state
-    while (m_next_sync_timestamp > 0) {
-    }
+    bool paused = pauseSampling();
 
-    auto time_idx = m_sampler.getTimeIndices(time_limits.min, time_limits.max);
+    // Time column comes from the domain of the first signal. Signals from
+    // other domains have different timestamps and are left out.
+    DbgGui_SamplingDomain* domain = scalars.empty() ? nullptr : scalars.front()->sampling_domain;
+    ScrollingBuffer& domain_sampler = domain ? domain->sampler : m_sampler;
+    auto time_idx = domain_sampler.getTimeIndices(time_limits.min, time_limits.max);
     if (time_idx.first < 0 || time_idx.second < 0) {
-        m_paused = paused;
+        setPaused(paused);
         return samples;
     }
 
-    std::vector<double> time = m_sampler.getTimeInRange(time_idx);
+    std::vector<double> time = domain_sampler.getTimeInRange(time_idx);
     if (time.empty()) {
-        m_paused = paused;
+        setPaused(paused);
         return samples;
     }
 
@@ -809,13 +909,13 @@ SampleClipboardData DbgGui::collectScalarSamples(std::vector<Scalar*> const& sca
     samples.data.push_back(std::move(time));
 
     for (auto const& scalar : scalars) {
-        if (!m_sampler.isScalarSampled(scalar)) {
+        if (scalar->sampling_domain != domain || !domain_sampler.isScalarSampled(scalar)) {
             continue;
         }
-        std::vector<double> scalar_samples = m_sampler.getSamplesInRange(scalar,
-                                                                         time_idx,
-                                                                         scalar->getScale(),
-                                                                         scalar->getOffset());
+        std::vector<double> scalar_samples = domain_sampler.getSamplesInRange(scalar,
+                                                                              time_idx,
+                                                                              scalar->getScale(),
+                                                                              scalar->getOffset());
         if (scalar_samples.empty()) {
             continue;
         }
@@ -825,11 +925,11 @@ SampleClipboardData DbgGui::collectScalarSamples(std::vector<Scalar*> const& sca
 
     if (samples.data.size() <= 2) {
         samples = {};
-        m_paused = paused;
+        setPaused(paused);
         return samples;
     }
 
-    m_paused = paused;
+    setPaused(paused);
     return samples;
 }
 
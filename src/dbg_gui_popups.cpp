@@ -129,24 +129,16 @@ void DbgGui::addPopupModal(std::string const& modal_name) {
 
 void DbgGui::saveSnapshot() {
     // Pause during snapshot saving so that all symbols are from same time instant
-    bool paused = m_paused;
-    m_paused = true;
-    // Wait until main thread goes to pause state
-    while (m_next_sync_timestamp > 0) {
-    }
+    bool paused = pauseSampling();
     m_saved_snapshot = m_symbols.saveSnapshotToMemory();
-    m_paused = paused;
+    setPaused(paused);
 }
 
 void DbgGui::loadSnapshot() {
     // Pause during snapshot loading so that the execution continues from point when load button was pressed
-    bool paused = m_paused;
-    m_paused = true;
-    // Wait until main thread goes to pause state
-    while (m_next_sync_timestamp > 0) {
-    }
+    bool paused = pauseSampling();
     m_symbols.loadSnapshotFromMemory(m_saved_snapshot);
-    m_paused = paused;
+    setPaused(paused);
 }
 
 void DbgGui::showErrorModal() {
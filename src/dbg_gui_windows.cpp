@@ -23,6 +23,7 @@
 #include "dbg_gui_internal.h"
 #include "imgui.h"
 #include "imgui_stdlib.h"
+#include "implot.h"
 #include "str_helpers.h"
 #include "imgui_internal.h"
 #include "lua_syntax_highlighter.h"
@@ -402,6 +403,13 @@ void DbgGui::addScalarContextMenu(Scalar* scalar, bool show_delete) {
             m_pause_triggers.push_back(PauseTrigger(scalar, pause_level));
             ImGui::CloseCurrentPopup();
         }
+        double capture_level = scalar->getScaledValue();
+        if (ImGui::InputDouble("Capture trigger level", &capture_level, 0, 0, "%g", ImGuiInputTextFlags_EnterReturnsTrue)) {
+            armCapture(scalar, capture_level);
+            ImGui::CloseCurrentPopup();
+        }
+        ImGui::SameLine();
+        HelpMarker("Captures the samples around the trigger to the Captures window. Selected scalars are captured together with this scalar.");
         if (std::optional<std::string> error = addScalarScaleInput(scalar, m_selected_scalars)) {
             logMessage(*error);
         }
@@ -422,6 +430,13 @@ void DbgGui::addScalarContextMenu(Scalar* scalar, bool show_delete) {
             ImGui::CloseCurrentPopup();
         }
 
+        int sample_divider = int(scalar->sample_divider);
+        if (ImGui::InputInt("Sample every Nth", &sample_divider, 0, 0, ImGuiInputTextFlags_EnterReturnsTrue)) {
+            setSampleDivider(scalar, uint32_t(std::max(sample_divider, 1)));
+        }
+        ImGui::SameLine();
+        HelpMarker("Read the scalar only on every Nth sample. Slow signals take less time and memory. Plots and exports hold the value until the next sample.");
+
         if (ImGui::InputText("Alias##scalar_context_menu", &scalar->alias)) {
             if (scalar->alias.empty()) {
                 scalar->alias = scalar->name;
@@ -721,16 +736,42 @@ void DbgGui::showMainMenuBar() {
 
             ImGui::Checkbox("Show latest message on main menu bar", &m_options.show_latest_message_on_main_menu_bar);
             ImGui::Checkbox("Show vertical line in all plots", &m_options.show_vertical_line_in_all_plots);
+            if (ImGui::Checkbox("Performance window", &m_show_performance_window) && m_show_performance_window) {
+                m_profiler.setEnabled(true);
+            }
+            ImGui::SameLine();
+            HelpMarker("Show the time DbgGui spends in sampling and drawing.");
 
             // Theme
             themeCombo(m_options.theme, m_window);
 
             static int new_buffer_size = m_options.sampling_buffer_size;
             if (ImGui::InputInt("Sampling buffer size", &new_buffer_size, 0, 0, ImGuiInputTextFlags_EnterReturnsTrue)) {
-                std::scoped_lock<std::mutex> lock(m_sampling_mutex);
                 m_options.sampling_buffer_size = new_buffer_size;
                 m_sampler.setBufferSize(new_buffer_size);
+                for (std::unique_ptr<DbgGui_SamplingDomain> const& domain : m_sampling_domains) {
+                    domain->sampler.setBufferSize(new_buffer_size);
+                }
+            }
+
+            static std::string new_history_file = m_options.history_file;
+            if (ImGui::InputText("History file", &new_history_file, ImGuiInputTextFlags_EnterReturnsTrue)) {
+                m_options.history_file = new_history_file;
+                openHistoryFile();
+            }
+            ImGui::SameLine();
+            HelpMarker(std::format("Record the newest {} samples also to a memory mapped {} file that survives a crash and can be "
+                                   "opened with the CSV plotter. Leave empty to disable.",
+                                   m_options.history_file_size,
+                                   HISTORY_FILE_EXTENSION)
+                         .c_str());
+
+            if (ImGui::InputInt("Speed sync interval [ms]", &m_options.sync_interval_ms, 0, 0, ImGuiInputTextFlags_EnterReturnsTrue)) {
+                m_options.sync_interval_ms = std::clamp(m_options.sync_interval_ms, 1, 100);
             }
+            ImGui::SameLine();
+            HelpMarker("Interval of wall clock time at which sampling is paced to the simulation speed. Shorter interval gives smoother "
+                       "pacing but wakes up the sampling thread more often.");
 
             if (ImGui::InputInt("Font size", &m_options.font_size, 0, 0, ImGuiInputTextFlags_EnterReturnsTrue)) {
                 m_options.font_size = std::clamp((int)m_options.font_size, MIN_FONT_SIZE, MAX_FONT_SIZE - 1);
@@ -762,7 +803,7 @@ void DbgGui::showMainMenuBar() {
         // Start stop
         const char* start_stop_text = m_paused ? "Start" : "Pause";
         if (ImGui::Button(start_stop_text)) {
-            m_paused = !m_paused;
+            setPaused(!m_paused);
         }
         HelpMarker("Hotkey for start/pause is space. Shift+space advances one step. Hold shift+space to advance very slowly.");
         ImGui::SameLine();
@@ -771,6 +812,10 @@ void DbgGui::showMainMenuBar() {
         // Simulation speed
         ImGui::PushItemWidth(ImGui::CalcTextSize("Simulation speed XXXXXXX").x);
         ImGui::SliderFloat("##Simulation speed", &m_simulation_speed, 1e-4f, 10, "Simulation speed %.3f", ImGuiSliderFlags_Logarithmic | ImGuiSliderFlags_NoRoundToFormat);
+        if (ImGui::IsItemHovered() && !m_paused) {
+            DbgGui_PacingStatistics pacing = m_pacing_clock.statistics();
+            ImGui::SetTooltip("Pacing error mean %.3f ms, max %.3f ms", pacing.mean_error * 1e3, pacing.max_error * 1e3);
+        }
         ImGui::SameLine();
         HelpMarker("Simulated speed relative to real time. Hotkey to double speed is \"numpad +\" and halve \"numpad -\".");
         ImGui::SameLine();
@@ -830,6 +875,152 @@ void DbgGui::showLogWindow() {
     ImGui::End();
 }
 
+void DbgGui::showCaptureWindow() {
+    struct TriggerInfo {
+        uint64_t id;
+        std::string name;
+        CaptureSettings settings;
+        size_t capture_count;
+        bool armed;
+    };
+    std::vector<TriggerInfo> triggers;
+    if (!m_capture_engine.empty()) {
+        std::scoped_lock lock(m_sampling_mutex);
+        for (CaptureTrigger const& trigger : m_capture_engine.triggers()) {
+            triggers.push_back({trigger.id(), trigger.name(), trigger.settings(), trigger.captureCount(), trigger.armed()});
+        }
+    }
+    // Window is shown only after the first capture has been armed
+    if (triggers.empty() && m_captures.empty()) {
+        return;
+    }
+
+    if (!ImGui::Begin("Captures", NULL, ImGuiWindowFlags_NoNavFocus)) {
+        ImGui::End();
+        return;
+    }
+
+    int pre_samples = int(m_capture_settings.pre_samples);
+    if (ImGui::InputInt("Pre-trigger samples", &pre_samples, 0, 0, ImGuiInputTextFlags_EnterReturnsTrue)) {
+        m_capture_settings.pre_samples = size_t(std::max(pre_samples, 0));
+    }
+    int post_samples = int(m_capture_settings.post_samples);
+    if (ImGui::InputInt("Post-trigger samples", &post_samples, 0, 0, ImGuiInputTextFlags_EnterReturnsTrue)) {
+        m_capture_settings.post_samples = size_t(std::max(post_samples, 0));
+    }
+    ImGui::Combo("Edge", reinterpret_cast<int*>(&m_capture_settings.edge), "Rising\0Falling\0Either\0\0");
+    ImGui::Checkbox("Rearm", &m_capture_settings.rearm);
+    ImGui::SameLine();
+    HelpMarker("Settings for new captures. Captures are armed from the context menu of a scalar.");
+
+    std::optional<uint64_t> trigger_to_remove;
+    for (TriggerInfo const& trigger : triggers) {
+        ImGui::PushID(int(trigger.id));
+        if (ImGui::Button("Remove")) {
+            trigger_to_remove = trigger.id;
+        }
+        ImGui::SameLine();
+        constexpr const char* edges[] = {"rising", "falling", "either"};
+        ImGui::Text("%s %s %g, %zu captures%s",
+                    trigger.name.c_str(),
+                    edges[int(trigger.settings.edge)],
+                    trigger.settings.level,
+                    trigger.capture_count,
+                    trigger.armed ? "" : ", done");
+        ImGui::PopID();
+    }
+    if (trigger_to_remove) {
+        std::scoped_lock lock(m_sampling_mutex);
+        m_capture_engine.disarm(*trigger_to_remove);
+    }
+
+    ImGui::Separator();
+    if (ImGui::Button("Clear captures")) {
+        m_captures.clear();
+        m_selected_capture = -1;
+    }
+    ImGui::BeginChild("##capture_list", ImVec2(ImGui::GetContentRegionAvail().x * 0.25f, 0), true);
+    for (int i = 0; i < int(m_captures.size()); ++i) {
+        std::string label = std::format("{} t={:g}##{}", m_captures[i].trigger_name, m_captures[i].trigger_time, i);
+        if (ImGui::Selectable(label.c_str(), m_selected_capture == i)) {
+            m_selected_capture = i;
+        }
+    }
+    ImGui::EndChild();
+    ImGui::SameLine();
+
+    if (m_selected_capture >= 0 && m_selected_capture < int(m_captures.size())) {
+        Capture const& capture = m_captures[m_selected_capture];
+        if (ImPlot::BeginPlot("##Capture", ImVec2(-1, ImGui::GetContentRegionAvail().y))) {
+            ImPlot::SetupAxes("Time [s]", nullptr, ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+            ImPlot::TagX(capture.trigger_time, ImVec4(1, 1, 1, 0.5f), true);
+            for (size_t i = 0; i < capture.names.size(); ++i) {
+                ImPlot::PlotLine(capture.names[i].c_str(),
+                                 capture.time.data(),
+                                 capture.values[i].data(),
+                                 int(capture.time.size()));
+            }
+            ImPlot::EndPlot();
+        }
+    }
+    ImGui::End();
+}
+
+void DbgGui::showPerformanceWindow() {
+    if (!m_show_performance_window) {
+        return;
+    }
+    if (!ImGui::Begin("DbgGui performance", &m_show_performance_window, ImGuiWindowFlags_NoNavFocus)) {
+        ImGui::End();
+        return;
+    }
+
+    bool enabled = m_profiler.enabled();
+    if (ImGui::Checkbox("Profiling", &enabled)) {
+        m_profiler.setEnabled(enabled);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Reset")) {
+        m_profiler.reset();
+    }
+    ImGui::SameLine();
+    HelpMarker("Select a row to show the histogram of its latest durations. Waiting for vsync is not included in the frame time.");
+
+    static ProfileSection selected_section = ProfileSection::Sampling;
+    if (ImGui::BeginTable("performance_table", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable)) {
+        const float num_width = ImGui::CalcTextSize("0000000000").x;
+        ImGui::TableSetupColumn("Section", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Count", ImGuiTableColumnFlags_WidthFixed, num_width);
+        ImGui::TableSetupColumn("Mean [us]", ImGuiTableColumnFlags_WidthFixed, num_width);
+        ImGui::TableSetupColumn("Max [us]", ImGuiTableColumnFlags_WidthFixed, num_width);
+        ImGui::TableHeadersRow();
+        for (size_t i = 0; i < size_t(ProfileSection::Count); ++i) {
+            ProfileSection section = ProfileSection(i);
+            Profiler::Totals totals = m_profiler.totals(section);
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            if (ImGui::Selectable(PROFILE_SECTION_NAMES[i], selected_section == section, ImGuiSelectableFlags_SpanAllColumns)) {
+                selected_section = section;
+            }
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", (unsigned long long)totals.count);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", totals.count > 0 ? totals.total_time / double(totals.count) * 1e6 : 0.0);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", totals.max_time * 1e6);
+        }
+        ImGui::EndTable();
+    }
+
+    std::vector<float> durations = m_profiler.history(selected_section);
+    if (ImPlot::BeginPlot("##Performance histogram", ImVec2(-1, ImGui::GetContentRegionAvail().y))) {
+        ImPlot::SetupAxes("Duration [us]", "Count", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+        ImPlot::PlotHistogram(PROFILE_SECTION_NAMES[size_t(selected_section)], durations.data(), int(durations.size()));
+        ImPlot::EndPlot();
+    }
+    ImGui::End();
+}
+
 void DbgGui::showScalarWindow() {
     m_window_focus.scalars.focused = ImGui::Begin("Scalars", NULL, ImGuiWindowFlags_NoNavFocus);
     if (!m_window_focus.scalars.focused) {
@@ -902,9 +1093,10 @@ void DbgGui::showScalarWindow() {
                             new_scalar->setScaleStr(scalar->getScaleStr());
                             new_scalar->setOffsetStr(scalar->getOffsetStr());
                             scalar->deleted = true;
-                            if (m_sampler.isScalarSampled(scalar)) {
-                                m_sampler.startSampling(new_scalar);
-                                m_sampler.copySamples(*scalar, *new_scalar);
+                            setSamplingDomain(new_scalar, scalar->sampling_domain);
+                            if (sampler(scalar).isScalarSampled(scalar)) {
+                                sampler(new_scalar).startSampling(new_scalar);
+                                sampler(new_scalar).copySamples(*scalar, *new_scalar);
                             }
                             scalar->replacement = new_scalar;
                         }
@@ -1094,9 +1286,11 @@ void DbgGui::showVectorWindow() {
                             new_vector->y->setScaleStr(vector->y->getScaleStr());
                             new_vector->x->setOffsetStr(vector->x->getOffsetStr());
                             new_vector->y->setOffsetStr(vector->y->getOffsetStr());
-                            if (m_sampler.isScalarSampled(vector->x) || m_sampler.isScalarSampled(vector->y)) {
-                                m_sampler.startSampling(new_vector);
-                                m_sampler.copySamples(*vector, *new_vector);
+                            setSamplingDomain(new_vector->x, vector->x->sampling_domain);
+                            if (sampler(vector->x).isScalarSampled(vector->x) || sampler(vector->y).isScalarSampled(vector->y)) {
+                                startSampling(new_vector);
+                                sampler(vector->x).copySamples(*vector->x, *new_vector->x);
+                                sampler(vector->y).copySamples(*vector->y, *new_vector->y);
                             }
                             vector->deleted = true;
                             vector->replacement = new_vector;
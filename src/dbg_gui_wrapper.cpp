@@ -22,6 +22,7 @@
 
 #include "DbgGui/dbg_gui.h"
 #include "dbg_gui_internal.h"
+#include <algorithm>
 #include <memory>
 
 static std::unique_ptr<DbgGui> g_dbg_gui;
@@ -92,6 +93,38 @@ void DbgGui_addVector_f64(double* x, double* y, const char* group, const char* n
     DbgGui_addVector(x, y, group, name);
 }
 
+void DbgGui_setSampleDivider(const char* group, const char* name, uint32_t divider) {
+    if (g_dbg_gui) {
+        g_dbg_gui->setSampleDividerAsync(group, name, divider);
+    }
+}
+
+DbgGui_SamplingDomain* DbgGui_addSamplingDomain(const char* name) {
+    if (g_dbg_gui) {
+        return g_dbg_gui->addSamplingDomain(name);
+    }
+    return nullptr;
+}
+
+void DbgGui_setSamplingDomain(const char* group, const char* name, DbgGui_SamplingDomain* domain) {
+    if (g_dbg_gui) {
+        g_dbg_gui->setSamplingDomainAsync(group, name, domain);
+    }
+}
+
+void DbgGui_sampleDomain(DbgGui_SamplingDomain* domain, double timestamp) {
+    if (g_dbg_gui && domain) {
+        g_dbg_gui->sampleDomain(*domain, timestamp);
+    }
+}
+
+double DbgGui_wallClockTime(void) {
+    if (g_dbg_gui) {
+        return g_dbg_gui->wallClockTime();
+    }
+    return 0;
+}
+
 void DbgGui_create(double sampling_time) {
     g_dbg_gui = std::make_unique<DbgGui>(sampling_time);
 }
@@ -114,6 +147,44 @@ void DbgGui_sampleWithTimestamp(double timestamp) {
     }
 }
 
+void DbgGui_sampleBatch(const double* timestamps, size_t count, const DbgGui_SampleBlock* blocks, size_t block_count) {
+    if (g_dbg_gui) {
+        g_dbg_gui->sampleBatch(std::span(timestamps, count), std::span(blocks, block_count));
+    }
+}
+
+void DbgGui_sampleBatch(std::vector<double> const& timestamps, std::vector<DbgGui_SampleBlock> const& blocks) {
+    DbgGui_sampleBatch(timestamps.data(), timestamps.size(), blocks.data(), blocks.size());
+}
+
+void DbgGui_startBackgroundSampling(double sampling_time) {
+    if (g_dbg_gui) {
+        g_dbg_gui->startBackgroundSampling(sampling_time);
+    }
+}
+
+DbgGui_PacingStatistics DbgGui_getPacingStatistics(void) {
+    if (g_dbg_gui) {
+        return g_dbg_gui->pacingStatistics();
+    }
+    return {};
+}
+
+void DbgGui_setProfilingEnabled(int enabled) {
+    if (g_dbg_gui) {
+        g_dbg_gui->setProfilingEnabled(enabled != 0);
+    }
+}
+
+size_t DbgGui_getProfile(DbgGui_ProfileSection* sections, size_t max_count) {
+    if (!g_dbg_gui) {
+        return 0;
+    }
+    std::vector<DbgGui_ProfileSection> profile = g_dbg_gui->profile();
+    std::copy_n(profile.begin(), std::min(max_count, profile.size()), sections);
+    return profile.size();
+}
+
 int DbgGui_isClosed(void) {
     if (g_dbg_gui) {
         return g_dbg_gui->isClosed();
@@ -0,0 +1,148 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include "minmax.h"
+#include "plot_decimation.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+// Decimated buckets of a scrolling plot on a fixed grid of sample indices.
+// Bucket b covers samples [b * bucket_size, (b + 1) * bucket_size) so a bucket
+// stays the same while the plot scrolls and only the buckets that scrolled in
+// have to be computed. Buckets that have all their samples are kept until
+// they scroll out of the plot.
+class DecimationCache {
+  public:
+    // Bucket size for plotting sample_count samples with about count points.
+    // Powers of two keep the grid the same while the sample count of the plot
+    // changes a little between frames and the buckets cover whole blocks of a
+    // MinMaxPyramid.
+    static uint64_t bucketSize(uint64_t sample_count, int count) {
+        count = std::clamp(count, MIN_PLOT_SAMPLE_COUNT, MAX_PLOT_SAMPLE_COUNT);
+        uint64_t samples_per_point = (sample_count + uint64_t(count) - 1) / uint64_t(count);
+        return std::bit_ceil(MAX(samples_per_point, uint64_t(1)));
+    }
+
+    explicit DecimationCache(uint64_t bucket_size)
+        : m_bucket_size(bucket_size) {}
+
+    uint64_t bucketSize() const {
+        return m_bucket_size;
+    }
+
+    // Number of kept buckets
+    size_t size() const {
+        return m_buckets.size();
+    }
+
+    void clear() {
+        m_buckets.clear();
+    }
+
+    // Decimates samples [first, last). Samples [stored_first, stored_last)
+    // are read with min_max(begin, end, min, max), which widens min and max,
+    // and the other samples were not sampled. last must not be after
+    // stored_last. time(k) returns the x value of sample k for samples
+    // [min(first, stored_first), stored_last).
+    template <typename Time, typename MinMaxOf>
+    DecimatedValues decimate(uint64_t first,
+                             uint64_t last,
+                             uint64_t stored_first,
+                             uint64_t stored_last,
+                             Time const& time,
+                             MinMaxOf const& min_max,
+                             DecimationTransform const& transform) {
+        DecimatedValues values;
+        if (last <= first) {
+            return values;
+        }
+        uint64_t first_bucket = first / m_bucket_size;
+        uint64_t end_bucket = (last - 1) / m_bucket_size + 1;
+        // Buckets that scrolled out
+        while (!m_buckets.empty() && m_first_bucket < first_bucket) {
+            m_buckets.pop_front();
+            ++m_first_bucket;
+        }
+        while (!m_buckets.empty() && m_first_bucket + m_buckets.size() > end_bucket) {
+            m_buckets.pop_back();
+        }
+
+        values.x.reserve(size_t(end_bucket - first_bucket));
+        values.y_min.reserve(size_t(end_bucket - first_bucket));
+        values.y_max.reserve(size_t(end_bucket - first_bucket));
+        uint64_t time_first = MIN(first, stored_first);
+        for (uint64_t b = first_bucket; b < end_bucket; ++b) {
+            uint64_t begin = b * m_bucket_size;
+            uint64_t end = begin + m_bucket_size;
+            bool complete = begin >= stored_first && end <= stored_last;
+            Bucket bucket;
+            if (complete && b >= m_first_bucket && b < m_first_bucket + m_buckets.size()) {
+                bucket = m_buckets[size_t(b - m_first_bucket)];
+            } else {
+                // Buckets at the ends of the history are cut to the samples that exist
+                bucket.x = 0.5 * (time(MAX(begin, time_first)) + time(MIN(end, stored_last) - 1));
+                uint64_t min_max_begin = MAX(begin, stored_first);
+                uint64_t min_max_end = MIN(end, stored_last);
+                if (min_max_begin < min_max_end) {
+                    min_max(min_max_begin, min_max_end, bucket.min, bucket.max);
+                }
+                if (complete) {
+                    keep(b, bucket);
+                }
+            }
+            appendBucket(values, bucket.x, bucket.min, bucket.max, transform);
+        }
+        return values;
+    }
+
+  private:
+    struct Bucket {
+        double x = 0;
+        double min = INFINITY;
+        double max = -INFINITY;
+    };
+
+    // Buckets are kept contiguous. A bucket that is not next to the kept ones
+    // starts over, e.g. when the plot jumped while paused.
+    void keep(uint64_t b, Bucket const& bucket) {
+        if (!m_buckets.empty() && b + 1 == m_first_bucket) {
+            m_buckets.push_front(bucket);
+            m_first_bucket = b;
+        } else if (!m_buckets.empty() && b == m_first_bucket + m_buckets.size()) {
+            m_buckets.push_back(bucket);
+        } else {
+            m_buckets.clear();
+            m_buckets.push_back(bucket);
+            m_first_bucket = b;
+        }
+    }
+
+    uint64_t m_bucket_size;
+    uint64_t m_first_bucket = 0;
+    std::deque<Bucket> m_buckets;
+};
@@ -0,0 +1,267 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "history_file.h"
+#include "str_helpers.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <format>
+
+#if WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr char MAGIC[8] = "DBGHIST";
+constexpr uint32_t VERSION = 1;
+constexpr size_t HEADER_SIZE = 256;
+constexpr size_t COLUMN_NAME_SIZE = 248;
+constexpr size_t INITIAL_COLUMN_CAPACITY = 16;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t capacity;
+    uint64_t column_count;
+    // Rows committed so far. Row r is stored at index r % capacity.
+    uint64_t sample_count;
+};
+static_assert(sizeof(FileHeader) <= HEADER_SIZE);
+
+struct ColumnHeader {
+    char name[COLUMN_NAME_SIZE]; // Empty for unused columns
+    uint64_t valid_from;
+};
+static_assert(sizeof(ColumnHeader) == HEADER_SIZE);
+
+size_t timeOffset() {
+    return HEADER_SIZE;
+}
+
+size_t columnOffset(size_t capacity, size_t column) {
+    size_t values_size = capacity * sizeof(double);
+    return HEADER_SIZE + values_size + column * (HEADER_SIZE + values_size);
+}
+
+size_t fileSize(size_t capacity, size_t column_count) {
+    return columnOffset(capacity, column_count);
+}
+
+} // namespace
+
+HistoryFile::HistoryFile(std::string filename, size_t capacity)
+    : m_filename(std::move(filename)),
+      m_capacity(capacity) {
+}
+
+HistoryFile::~HistoryFile() {
+    unmap();
+#if WINDOWS
+    if (m_file != nullptr) {
+        CloseHandle(m_file);
+    }
+#else
+    if (m_file >= 0) {
+        close(m_file);
+    }
+#endif
+}
+
+std::expected<std::unique_ptr<HistoryFile>, std::string> HistoryFile::create(std::string const& filename, size_t capacity) {
+    if (capacity == 0) {
+        return std::unexpected(std::format("History file {} must hold at least one sample", filename));
+    }
+    std::unique_ptr<HistoryFile> file(new HistoryFile(filename, capacity));
+#if WINDOWS
+    HANDLE handle = CreateFileA(filename.c_str(),
+                                GENERIC_READ | GENERIC_WRITE,
+                                FILE_SHARE_READ,
+                                nullptr,
+                                CREATE_ALWAYS,
+                                FILE_ATTRIBUTE_NORMAL,
+                                nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return std::unexpected(std::format("Error opening history file: {}", filename));
+    }
+    file->m_file = handle;
+#else
+    int fd = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return std::unexpected(std::format("Error opening history file: {}", filename));
+    }
+    file->m_file = fd;
+#endif
+    if (!file->map(INITIAL_COLUMN_CAPACITY)) {
+        return std::unexpected(std::format("Error mapping history file: {}", filename));
+    }
+    FileHeader* header = reinterpret_cast<FileHeader*>(file->m_data);
+    std::memcpy(header->magic, MAGIC, sizeof(MAGIC));
+    header->version = VERSION;
+    header->capacity = capacity;
+    return file;
+}
+
+bool HistoryFile::map(size_t column_capacity) {
+    size_t size = fileSize(m_capacity, column_capacity);
+#if WINDOWS
+    HANDLE mapping = CreateFileMappingA(m_file, nullptr, PAGE_READWRITE, DWORD(uint64_t(size) >> 32), DWORD(size), nullptr);
+    if (mapping == nullptr) {
+        return false;
+    }
+    void* data = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (data == nullptr) {
+        CloseHandle(mapping);
+        return false;
+    }
+    m_mapping = mapping;
+#else
+    if (ftruncate(m_file, off_t(size)) != 0) {
+        return false;
+    }
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_file, 0);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+#endif
+    m_data = static_cast<char*>(data);
+    m_size = size;
+    m_column_capacity = column_capacity;
+    return true;
+}
+
+void HistoryFile::unmap() {
+    if (m_data == nullptr) {
+        return;
+    }
+#if WINDOWS
+    UnmapViewOfFile(m_data);
+    CloseHandle(m_mapping);
+    m_mapping = nullptr;
+#else
+    munmap(m_data, m_size);
+#endif
+    m_data = nullptr;
+    m_size = 0;
+}
+
+bool HistoryFile::setColumn(size_t column, std::string const& name, uint64_t valid_from) {
+    if (column >= m_column_capacity) {
+        // Grow by remapping the larger file. New columns are zero filled by the
+        // operating system so they have no name.
+        size_t old_capacity = m_column_capacity;
+        unmap();
+        if (!map(std::max(2 * old_capacity, column + 1)) && !map(old_capacity)) {
+            // Nothing is mapped anymore so no column can be written
+            m_column_capacity = 0;
+            return false;
+        }
+        if (column >= m_column_capacity) {
+            return false;
+        }
+    }
+    FileHeader* header = reinterpret_cast<FileHeader*>(m_data);
+    header->column_count = std::max<uint64_t>(header->column_count, column + 1);
+    ColumnHeader* column_header = reinterpret_cast<ColumnHeader*>(m_data + columnOffset(m_capacity, column));
+    std::memset(column_header->name, 0, COLUMN_NAME_SIZE);
+    std::memcpy(column_header->name, name.data(), std::min(name.size(), COLUMN_NAME_SIZE - 1));
+    column_header->valid_from = valid_from;
+    return true;
+}
+
+double* HistoryFile::columnData(size_t column) {
+    if (column >= m_column_capacity) {
+        return nullptr;
+    }
+    return reinterpret_cast<double*>(m_data + columnOffset(m_capacity, column) + HEADER_SIZE);
+}
+
+void HistoryFile::commitRow(uint64_t row, double time) {
+    if (m_data == nullptr) {
+        return;
+    }
+    reinterpret_cast<double*>(m_data + timeOffset())[row % m_capacity] = time;
+    FileHeader* header = reinterpret_cast<FileHeader*>(m_data);
+    std::atomic_ref<uint64_t>(header->sample_count).store(row + 1, std::memory_order_release);
+}
+
+std::expected<HistoryFileData, std::string> readHistoryFile(std::string const& filename) {
+    auto content = str::readFile(filename);
+    if (!content) {
+        return std::unexpected(content.error());
+    }
+    std::string const& bytes = *content;
+    FileHeader header;
+    if (bytes.size() < HEADER_SIZE) {
+        return std::unexpected(std::format("{} is not a history file", filename));
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) {
+        return std::unexpected(std::format("{} is not a history file", filename));
+    }
+    size_t capacity = size_t(header.capacity);
+    size_t column_count = size_t(header.column_count);
+    if (capacity == 0 || bytes.size() < fileSize(capacity, column_count)) {
+        return std::unexpected(std::format("History file {} is truncated", filename));
+    }
+
+    // The row after the newest committed one may have been partially written
+    // over the oldest row when the writer stopped, so that row is skipped.
+    uint64_t sample_count = header.sample_count;
+    size_t count = sample_count > capacity - 1 ? capacity - 1 : size_t(sample_count);
+    uint64_t first = sample_count - count;
+    auto read_column = [&](size_t offset, uint64_t valid_from) {
+        std::vector<double> values(count);
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t row = first + i;
+            if (row < valid_from) {
+                values[i] = NAN;
+            } else {
+                std::memcpy(&values[i], bytes.data() + offset + size_t(row % capacity) * sizeof(double), sizeof(double));
+            }
+        }
+        return values;
+    };
+
+    HistoryFileData data;
+    data.names.push_back("time");
+    data.columns.push_back(read_column(timeOffset(), 0));
+    for (size_t column = 0; column < column_count; ++column) {
+        size_t offset = columnOffset(capacity, column);
+        ColumnHeader column_header;
+        std::memcpy(&column_header, bytes.data() + offset, sizeof(column_header));
+        column_header.name[COLUMN_NAME_SIZE - 1] = '\0';
+        if (column_header.name[0] == '\0') {
+            continue;
+        }
+        data.names.push_back(column_header.name);
+        data.columns.push_back(read_column(offset + HEADER_SIZE, column_header.valid_from));
+    }
+    return data;
+}
@@ -0,0 +1,99 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <string>
+#include <vector>
+
+inline constexpr char const* HISTORY_FILE_EXTENSION = ".dbghist";
+
+// Sample history ring that lives in a memory mapped file. The operating system
+// writes the mapped pages to disk even if the process crashes, so the newest
+// samples survive for post-mortem analysis.
+//
+// The file starts with a header containing the ring capacity and the number of
+// committed rows, followed by the time column and one block per column with
+// the column name and values. Columns are appended to the end of the file so
+// that adding columns never moves existing data.
+class HistoryFile {
+  public:
+    static std::expected<std::unique_ptr<HistoryFile>, std::string> create(std::string const& filename, size_t capacity);
+    ~HistoryFile();
+
+    HistoryFile(HistoryFile const&) = delete;
+    HistoryFile& operator=(HistoryFile const&) = delete;
+
+    // Names the column and marks rows before valid_from as not sampled. An
+    // empty name releases the column. Returns false if the file could not be
+    // grown, in which case the column is not recorded. If the file could not
+    // be mapped again after that, isMapped() is false and nothing is recorded.
+    bool setColumn(size_t column, std::string const& name, uint64_t valid_from);
+
+    // Values of the column or nullptr if the column does not exist. Row r is
+    // stored at index r % capacity(). Pointers are invalidated by setColumn().
+    double* columnData(size_t column);
+
+    // Publishes the row after all its values have been written
+    void commitRow(uint64_t row, double time);
+
+    bool isMapped() const {
+        return m_data != nullptr;
+    }
+
+    size_t capacity() const {
+        return m_capacity;
+    }
+
+    std::string const& filename() const {
+        return m_filename;
+    }
+
+  private:
+    HistoryFile(std::string filename, size_t capacity);
+    bool map(size_t column_capacity);
+    void unmap();
+
+    std::string m_filename;
+    size_t m_capacity;
+    size_t m_column_capacity = 0;
+    char* m_data = nullptr;
+    size_t m_size = 0;
+#if WINDOWS
+    void* m_file = nullptr;
+    void* m_mapping = nullptr;
+#else
+    int m_file = -1;
+#endif
+};
+
+struct HistoryFileData {
+    // First column is time
+    std::vector<std::string> names;
+    std::vector<std::vector<double>> columns;
+};
+
+// Reads the committed rows of a history file from the oldest to the newest
+std::expected<HistoryFileData, std::string> readHistoryFile(std::string const& filename);
@@ -0,0 +1,221 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include "minmax.h"
+#include "plot_decimation.h"
+#include "time_axis.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <vector>
+
+// Downsampled min/max history that reaches much further back than the raw
+// samples. Every tier reduces a fixed number of raw samples into one min/max
+// bucket and keeps enough of them per slot to reach a multiple of the raw
+// history. Tiers are fed one raw row at a time and each tier feeds the next
+// coarser one when its bucket is complete.
+//
+// The buckets of a slot take 2 * 8 * (N / 32 + N / 128) bytes for a raw history
+// of N rows, i.e. 0.625 bytes per row or 625 kB with a million rows.
+class HistoryTiers {
+  public:
+    // Raw samples per bucket in each tier from finest to coarsest
+    static constexpr std::array<size_t, 2> FACTORS = {64, 4096};
+    // Raw history lengths that each tier reaches back
+    static constexpr std::array<size_t, 2> REACH = {2, 32};
+    // Lower limit for short raw histories
+    static constexpr size_t MIN_BUCKETS = 256;
+
+    // Sizes the tiers for a raw history of buffer_size rows. The oldest
+    // buckets that no longer fit are dropped.
+    void setBufferSize(size_t buffer_size) {
+        for (size_t tier_idx = 0; tier_idx < m_tiers.size(); ++tier_idx) {
+            Tier& tier = m_tiers[tier_idx];
+            size_t buckets = std::max(buffer_size * REACH[tier_idx] / FACTORS[tier_idx], MIN_BUCKETS);
+            if (buckets == tier.buckets) {
+                continue;
+            }
+            tier.time.popFront(tier.time.size() - std::min(tier.time.size(), buckets));
+            // Buckets are stored at their index modulo the bucket count
+            std::vector<double> min(m_slot_count * buckets, NAN);
+            std::vector<double> max(m_slot_count * buckets, NAN);
+            for (size_t slot = 0; slot < m_slot_count; ++slot) {
+                for (uint64_t k = tier.time.begin(); k < tier.time.end(); ++k) {
+                    min[slot * buckets + size_t(k % buckets)] = tier.min[slot * tier.buckets + size_t(k % tier.buckets)];
+                    max[slot * buckets + size_t(k % buckets)] = tier.max[slot * tier.buckets + size_t(k % tier.buckets)];
+                }
+            }
+            tier.min = std::move(min);
+            tier.max = std::move(max);
+            tier.buckets = buckets;
+        }
+    }
+
+    void resizeSlots(size_t slot_count) {
+        for (Tier& tier : m_tiers) {
+            tier.min.resize(slot_count * tier.buckets, NAN);
+            tier.max.resize(slot_count * tier.buckets, NAN);
+            tier.pending_min.resize(slot_count, INFINITY);
+            tier.pending_max.resize(slot_count, -INFINITY);
+        }
+        m_slot_count = slot_count;
+    }
+
+    // Clears the history of a slot that is given to another scalar
+    void resetSlot(size_t slot) {
+        for (Tier& tier : m_tiers) {
+            std::fill_n(tier.min.begin() + slot * tier.buckets, tier.buckets, NAN);
+            std::fill_n(tier.max.begin() + slot * tier.buckets, tier.buckets, NAN);
+            tier.pending_min[slot] = INFINITY;
+            tier.pending_max[slot] = -INFINITY;
+        }
+    }
+
+    void copySlot(size_t from, size_t to) {
+        for (Tier& tier : m_tiers) {
+            std::copy_n(tier.min.begin() + from * tier.buckets, tier.buckets, tier.min.begin() + to * tier.buckets);
+            std::copy_n(tier.max.begin() + from * tier.buckets, tier.buckets, tier.max.begin() + to * tier.buckets);
+            tier.pending_min[to] = tier.pending_min[from];
+            tier.pending_max[to] = tier.pending_max[from];
+        }
+    }
+
+    // Raw value of the slot in the current row
+    void add(size_t slot, double value) {
+        Tier& tier = m_tiers[0];
+        tier.pending_min[slot] = MIN(value, tier.pending_min[slot]);
+        tier.pending_max[slot] = MAX(value, tier.pending_max[slot]);
+    }
+
+    // Completes the current row that was sampled at time
+    void endRow(double time) {
+        advance(0, time);
+    }
+
+    void shift(double offset) {
+        for (Tier& tier : m_tiers) {
+            tier.time.shift(offset);
+            tier.pending_time += offset;
+        }
+    }
+
+    // Timestamp of the oldest bucket in any tier
+    double oldestTime() const {
+        for (auto tier = m_tiers.rbegin(); tier != m_tiers.rend(); ++tier) {
+            if (!tier->time.empty()) {
+                return tier->time.at(tier->time.begin());
+            }
+        }
+        return INFINITY;
+    }
+
+    // Min/max of the slot over [start_time, end_time] from the finest tier
+    // that reaches back to start_time. Empty if there are no buckets in range.
+    DecimatedValues getValuesInRange(size_t slot, double start_time, double end_time, int count, DecimationTransform transform) const {
+        Tier const* tier = nullptr;
+        for (Tier const& candidate : m_tiers) {
+            if (!candidate.time.empty()) {
+                tier = &candidate;
+                if (candidate.time.at(candidate.time.begin()) <= start_time) {
+                    break;
+                }
+            }
+        }
+        if (tier == nullptr || tier->time.at(tier->time.begin()) > end_time) {
+            return {};
+        }
+
+        uint64_t first = tier->time.lastAtOrBefore(start_time);
+        uint64_t last = std::max(tier->time.lastAtOrBefore(end_time), first);
+        size_t bucket_count = size_t(last - first + 1);
+        auto column = [&](std::vector<double> const& values) {
+            return RingSpan<double>::fromRing(std::span(values).subspan(slot * tier->buckets, tier->buckets),
+                                              size_t(first % tier->buckets),
+                                              bucket_count);
+        };
+        return decimateMinMax([&](size_t i) { return tier->time.at(first + i); },
+                              column(tier->min),
+                              column(tier->max),
+                              count,
+                              transform);
+    }
+
+  private:
+    struct Tier {
+        TimeAxis time; // Time of the first raw sample in each bucket
+        std::vector<double> min;
+        std::vector<double> max;
+        // Bucket being collected
+        std::vector<double> pending_min;
+        std::vector<double> pending_max;
+        size_t pending_count = 0;
+        double pending_time = 0;
+        size_t buckets = MIN_BUCKETS;
+    };
+
+    void advance(size_t tier_idx, double time) {
+        Tier& tier = m_tiers[tier_idx];
+        if (tier.pending_count == 0) {
+            tier.pending_time = time;
+        }
+        size_t ratio = tier_idx == 0 ? FACTORS[0] : FACTORS[tier_idx] / FACTORS[tier_idx - 1];
+        if (++tier.pending_count < ratio) {
+            return;
+        }
+
+        Tier* next = tier_idx + 1 < m_tiers.size() ? &m_tiers[tier_idx + 1] : nullptr;
+        size_t pos = size_t(tier.time.end() % tier.buckets);
+        for (size_t slot = 0; slot < m_slot_count; ++slot) {
+            double lo = tier.pending_min[slot];
+            double hi = tier.pending_max[slot];
+            if (lo > hi) {
+                // Nothing sampled for the slot during the bucket
+                lo = NAN;
+                hi = NAN;
+            }
+            tier.min[slot * tier.buckets + pos] = lo;
+            tier.max[slot * tier.buckets + pos] = hi;
+            tier.pending_min[slot] = INFINITY;
+            tier.pending_max[slot] = -INFINITY;
+            if (next != nullptr) {
+                next->pending_min[slot] = MIN(lo, next->pending_min[slot]);
+                next->pending_max[slot] = MAX(hi, next->pending_max[slot]);
+            }
+        }
+        tier.time.push(tier.pending_time);
+        if (tier.time.size() > tier.buckets) {
+            tier.time.popFront();
+        }
+        tier.pending_count = 0;
+        if (next != nullptr) {
+            advance(tier_idx + 1, tier.pending_time);
+        }
+    }
+
+    std::array<Tier, FACTORS.size()> m_tiers;
+    size_t m_slot_count = 0;
+};
@@ -0,0 +1,300 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "minmax_kernel.h"
+
+#include "minmax.h"
+
+#include <atomic>
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define MINMAX_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+// MSVC allows AVX intrinsics in any function
+#define MINMAX_TARGET_AVX2
+#else
+#define MINMAX_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#else
+#define MINMAX_X86 0
+#endif
+
+namespace {
+
+// Applied to the result of every kernel so that they agree on the sign of zero
+void widen(double lo, double hi, double& min, double& max) {
+    if (lo > hi) {
+        // Empty or only NAN
+        return;
+    }
+    min = MIN(lo, min);
+    max = MAX(hi, max);
+    if (min == 0) {
+        min = 0.0;
+    }
+    if (max == 0) {
+        max = 0.0;
+    }
+}
+
+template <typename T>
+void minMaxScalar(std::span<T const> values, double& min, double& max) {
+    T lo = std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+    T hi = std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest();
+    for (T value : values) {
+        lo = MIN(value, lo);
+        hi = MAX(value, hi);
+    }
+    if (!values.empty()) {
+        widen(static_cast<double>(lo), static_cast<double>(hi), min, max);
+    }
+}
+
+#if MINMAX_X86
+
+// MINPD and MAXPD return the second operand if the first is NAN so the
+// running min and max are passed second to skip NAN like the scalar loop.
+
+void minMaxSse2(std::span<double const> values, double& min, double& max) {
+    double const* data = values.data();
+    size_t const n = values.size();
+    __m128d lo0 = _mm_set1_pd(std::numeric_limits<double>::infinity());
+    __m128d hi0 = _mm_set1_pd(-std::numeric_limits<double>::infinity());
+    __m128d lo1 = lo0;
+    __m128d hi1 = hi0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128d a = _mm_loadu_pd(data + i);
+        __m128d b = _mm_loadu_pd(data + i + 2);
+        lo0 = _mm_min_pd(a, lo0);
+        hi0 = _mm_max_pd(a, hi0);
+        lo1 = _mm_min_pd(b, lo1);
+        hi1 = _mm_max_pd(b, hi1);
+    }
+    alignas(16) double lanes_lo[2];
+    alignas(16) double lanes_hi[2];
+    _mm_store_pd(lanes_lo, _mm_min_pd(lo0, lo1));
+    _mm_store_pd(lanes_hi, _mm_max_pd(hi0, hi1));
+    double lo = MIN(lanes_lo[0], lanes_lo[1]);
+    double hi = MAX(lanes_hi[0], lanes_hi[1]);
+    for (; i < n; ++i) {
+        lo = MIN(data[i], lo);
+        hi = MAX(data[i], hi);
+    }
+    widen(lo, hi, min, max);
+}
+
+void minMaxSse2(std::span<float const> values, double& min, double& max) {
+    float const* data = values.data();
+    size_t const n = values.size();
+    __m128 lo0 = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    __m128 hi0 = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+    __m128 lo1 = lo0;
+    __m128 hi1 = hi0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128 a = _mm_loadu_ps(data + i);
+        __m128 b = _mm_loadu_ps(data + i + 4);
+        lo0 = _mm_min_ps(a, lo0);
+        hi0 = _mm_max_ps(a, hi0);
+        lo1 = _mm_min_ps(b, lo1);
+        hi1 = _mm_max_ps(b, hi1);
+    }
+    alignas(16) float lanes_lo[4];
+    alignas(16) float lanes_hi[4];
+    _mm_store_ps(lanes_lo, _mm_min_ps(lo0, lo1));
+    _mm_store_ps(lanes_hi, _mm_max_ps(hi0, hi1));
+    float lo = MIN(lanes_lo[0], lanes_lo[1], lanes_lo[2], lanes_lo[3]);
+    float hi = MAX(lanes_hi[0], lanes_hi[1], lanes_hi[2], lanes_hi[3]);
+    for (; i < n; ++i) {
+        lo = MIN(data[i], lo);
+        hi = MAX(data[i], hi);
+    }
+    widen(lo, hi, min, max);
+}
+
+MINMAX_TARGET_AVX2 void minMaxAvx2(std::span<double const> values, double& min, double& max) {
+    double const* data = values.data();
+    size_t const n = values.size();
+    __m256d lo0 = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+    __m256d hi0 = _mm256_set1_pd(-std::numeric_limits<double>::infinity());
+    __m256d lo1 = lo0;
+    __m256d hi1 = hi0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256d a = _mm256_loadu_pd(data + i);
+        __m256d b = _mm256_loadu_pd(data + i + 4);
+        lo0 = _mm256_min_pd(a, lo0);
+        hi0 = _mm256_max_pd(a, hi0);
+        lo1 = _mm256_min_pd(b, lo1);
+        hi1 = _mm256_max_pd(b, hi1);
+    }
+    alignas(32) double lanes_lo[4];
+    alignas(32) double lanes_hi[4];
+    _mm256_store_pd(lanes_lo, _mm256_min_pd(lo0, lo1));
+    _mm256_store_pd(lanes_hi, _mm256_max_pd(hi0, hi1));
+    double lo = MIN(lanes_lo[0], lanes_lo[1], lanes_lo[2], lanes_lo[3]);
+    double hi = MAX(lanes_hi[0], lanes_hi[1], lanes_hi[2], lanes_hi[3]);
+    for (; i < n; ++i) {
+        lo = MIN(data[i], lo);
+        hi = MAX(data[i], hi);
+    }
+    widen(lo, hi, min, max);
+}
+
+MINMAX_TARGET_AVX2 void minMaxAvx2(std::span<float const> values, double& min, double& max) {
+    float const* data = values.data();
+    size_t const n = values.size();
+    __m256 lo0 = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+    __m256 hi0 = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+    __m256 lo1 = lo0;
+    __m256 hi1 = hi0;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256 a = _mm256_loadu_ps(data + i);
+        __m256 b = _mm256_loadu_ps(data + i + 8);
+        lo0 = _mm256_min_ps(a, lo0);
+        hi0 = _mm256_max_ps(a, hi0);
+        lo1 = _mm256_min_ps(b, lo1);
+        hi1 = _mm256_max_ps(b, hi1);
+    }
+    alignas(32) float lanes_lo[8];
+    alignas(32) float lanes_hi[8];
+    _mm256_store_ps(lanes_lo, _mm256_min_ps(lo0, lo1));
+    _mm256_store_ps(lanes_hi, _mm256_max_ps(hi0, hi1));
+    float lo = lanes_lo[0];
+    float hi = lanes_hi[0];
+    for (int lane = 1; lane < 8; ++lane) {
+        lo = MIN(lanes_lo[lane], lo);
+        hi = MAX(lanes_hi[lane], hi);
+    }
+    for (; i < n; ++i) {
+        lo = MIN(data[i], lo);
+        hi = MAX(data[i], hi);
+    }
+    widen(lo, hi, min, max);
+}
+
+bool cpuSupportsAvx2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    bool os_saves_ymm = (info[2] & (1 << 27)) && (_xgetbv(0) & 0x6) == 0x6;
+    __cpuidex(info, 7, 0);
+    return os_saves_ymm && (info[1] & (1 << 5));
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif
+
+MinMaxKernel bestKernel() {
+#if MINMAX_X86
+    return cpuSupportsAvx2() ? MinMaxKernel::Avx2 : MinMaxKernel::Sse2;
+#else
+    return MinMaxKernel::Scalar;
+#endif
+}
+
+std::atomic<MinMaxKernel> g_kernel = bestKernel();
+
+template <typename T>
+void dispatch(std::span<T const> values, double& min, double& max) {
+#if MINMAX_X86
+    switch (g_kernel.load(std::memory_order_relaxed)) {
+        case MinMaxKernel::Avx2:
+            return minMaxAvx2(values, min, max);
+        case MinMaxKernel::Sse2:
+            return minMaxSse2(values, min, max);
+        case MinMaxKernel::Scalar:
+            break;
+    }
+#endif
+    minMaxScalar(values, min, max);
+}
+
+} // namespace
+
+void minMaxOf(std::span<double const> values, double& min, double& max) {
+    dispatch(values, min, max);
+}
+
+void minMaxOf(std::span<float const> values, double& min, double& max) {
+    dispatch(values, min, max);
+}
+
+// Integers have no NAN so the typed loops are left for the compiler to vectorize
+void minMaxOf(std::span<int8_t const> values, double& min, double& max) {
+    minMaxScalar(values, min, max);
+}
+
+void minMaxOf(std::span<int16_t const> values, double& min, double& max) {
+    minMaxScalar(values, min, max);
+}
+
+void minMaxOf(std::span<int32_t const> values, double& min, double& max) {
+    minMaxScalar(values, min, max);
+}
+
+void minMaxOf(std::span<uint8_t const> values, double& min, double& max) {
+    minMaxScalar(values, min, max);
+}
+
+void minMaxOf(std::span<uint16_t const> values, double& min, double& max) {
+    minMaxScalar(values, min, max);
+}
+
+void minMaxOf(std::span<uint32_t const> values, double& min, double& max) {
+    minMaxScalar(values, min, max);
+}
+
+bool isMinMaxKernelSupported(MinMaxKernel kernel) {
+    switch (kernel) {
+        case MinMaxKernel::Scalar:
+            return true;
+        case MinMaxKernel::Sse2:
+            return MINMAX_X86;
+        case MinMaxKernel::Avx2:
+            return bestKernel() == MinMaxKernel::Avx2;
+    }
+    return false;
+}
+
+MinMaxKernel minMaxKernel() {
+    return g_kernel.load();
+}
+
+bool setMinMaxKernel(MinMaxKernel kernel) {
+    if (!isMinMaxKernelSupported(kernel)) {
+        return false;
+    }
+    g_kernel.store(kernel);
+    return true;
+}
@@ -0,0 +1,51 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+// Min/max reduction used by the plot decimation. NAN values are skipped like
+// in MIN(value, min) loops. Every kernel returns the same bits: min and max
+// are order independent except for the sign of zero, which is always +0.
+enum class MinMaxKernel {
+    Scalar,
+    Sse2,
+    Avx2,
+};
+
+// Widens min and max with the values
+void minMaxOf(std::span<double const> values, double& min, double& max);
+void minMaxOf(std::span<float const> values, double& min, double& max);
+void minMaxOf(std::span<int8_t const> values, double& min, double& max);
+void minMaxOf(std::span<int16_t const> values, double& min, double& max);
+void minMaxOf(std::span<int32_t const> values, double& min, double& max);
+void minMaxOf(std::span<uint8_t const> values, double& min, double& max);
+void minMaxOf(std::span<uint16_t const> values, double& min, double& max);
+void minMaxOf(std::span<uint32_t const> values, double& min, double& max);
+
+bool isMinMaxKernelSupported(MinMaxKernel kernel);
+// Kernel used by minMaxOf for floating point values. The best one that the
+// CPU supports is selected at startup.
+MinMaxKernel minMaxKernel();
+// Returns false if the kernel is not supported by the CPU
+bool setMinMaxKernel(MinMaxKernel kernel);
@@ -0,0 +1,237 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include "minmax.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Min/max of power-of-two blocks of samples for answering the min/max of any
+// range of the newest samples in O(log n). Level 0 summarizes blocks of
+// BLOCK_SIZE samples and each level above combines two blocks of the level
+// below. Samples are addressed by their absolute index and blocks are kept in
+// rings that reach back over the capacity given to reset().
+//
+// Blocks are written as soon as their last sample is added. A block with a gap
+// in its samples is written with the samples it got so ranges should only
+// cover samples that were all added.
+class MinMaxPyramid {
+  public:
+    static constexpr size_t BLOCK_SHIFT = 6;
+    static constexpr size_t BLOCK_SIZE = size_t(1) << BLOCK_SHIFT;
+
+    // Sized for the newest capacity samples. Forgets all blocks.
+    void reset(size_t capacity) {
+        m_levels.clear();
+        for (size_t shift = BLOCK_SHIFT;; ++shift) {
+            size_t count = (capacity >> shift) + 2;
+            m_levels.push_back({.min = std::vector<double>(count, INFINITY), .max = std::vector<double>(count, -INFINITY)});
+            if ((size_t(1) << shift) >= capacity) {
+                break;
+            }
+        }
+        m_next = 0;
+    }
+
+    // Releases the blocks, e.g. when the samples are stored as runs
+    void clear() {
+        m_levels.clear();
+        m_levels.shrink_to_fit();
+        m_next = 0;
+    }
+
+    bool empty() const {
+        return m_levels.empty();
+    }
+
+    // Index of the sample after the newest added sample
+    uint64_t end() const {
+        return m_next;
+    }
+
+    void add(uint64_t k, double value) {
+        Level& level = m_levels[0];
+        uint64_t block = k >> BLOCK_SHIFT;
+        if (block != level.pending_block) {
+            startBlock(0, block);
+        }
+        level.pending_min = MIN(value, level.pending_min);
+        level.pending_max = MAX(value, level.pending_max);
+        m_next = k + 1;
+        if ((m_next & (BLOCK_SIZE - 1)) == 0) {
+            flush(0);
+        }
+    }
+
+    // Widens min and max with samples [first, last), which must all have been
+    // added. raw(begin, end) is called to widen them with the samples that
+    // are not covered by whole blocks, at most 2 * BLOCK_SIZE samples.
+    template <typename Raw>
+    void minMax(uint64_t first, uint64_t last, Raw&& raw, double& min, double& max) const {
+        uint64_t l = (first + BLOCK_SIZE - 1) >> BLOCK_SHIFT;
+        uint64_t r = last >> BLOCK_SHIFT;
+        if (m_levels.empty() || l >= r) {
+            if (first < last) {
+                raw(first, last);
+            }
+            return;
+        }
+        if (first < l << BLOCK_SHIFT) {
+            raw(first, l << BLOCK_SHIFT);
+        }
+        if (r << BLOCK_SHIFT < last) {
+            raw(r << BLOCK_SHIFT, last);
+        }
+        for (size_t level_idx = 0; l < r; ++level_idx) {
+            Level const& level = m_levels[level_idx];
+            if (level_idx + 1 == m_levels.size()) {
+                for (; l < r; ++l) {
+                    widen(level, l, min, max);
+                }
+                break;
+            }
+            if (l & 1) {
+                widen(level, l++, min, max);
+            }
+            if (r & 1) {
+                widen(level, --r, min, max);
+            }
+            l >>= 1;
+            r >>= 1;
+        }
+    }
+
+    // Pyramid of the same samples sized for a new capacity. The blocks being
+    // collected continue from where they were. Their samples so far are
+    // summarized from this pyramid, with raw(begin, end, min, max) widening
+    // min and max with raw samples. Samples before oldest are left out. The
+    // complete blocks are taken over later with moveBlocks().
+    template <typename Raw>
+    MinMaxPyramid resized(size_t capacity, uint64_t oldest, Raw&& raw) const {
+        MinMaxPyramid pyramid;
+        pyramid.reset(capacity);
+        pyramid.m_next = m_next;
+        for (size_t level_idx = 0; level_idx < pyramid.m_levels.size(); ++level_idx) {
+            Level& level = pyramid.m_levels[level_idx];
+            size_t shift = BLOCK_SHIFT + level_idx;
+            uint64_t block = m_next >> shift;
+            uint64_t first = std::max(block << shift, oldest);
+            if (first < m_next) {
+                level.pending_block = block;
+                minMax(
+                  first, m_next, [&](uint64_t begin, uint64_t end) { raw(begin, end, level.pending_min, level.pending_max); }, level.pending_min, level.pending_max);
+            }
+        }
+        return pyramid;
+    }
+
+    // Takes over the blocks of from that start within samples [first, last)
+    // and were complete. Level 0 is copied and the levels above are combined
+    // from their children so that blocks started in newer ranges must have
+    // been moved already.
+    void moveBlocks(MinMaxPyramid const& from, uint64_t first, uint64_t last) {
+        if (from.m_levels.empty()) {
+            return;
+        }
+        for (size_t level_idx = 0; level_idx < m_levels.size(); ++level_idx) {
+            size_t shift = BLOCK_SHIFT + level_idx;
+            uint64_t size = uint64_t(1) << shift;
+            uint64_t block_end = std::min((last + size - 1) >> shift, from.m_next >> shift);
+            Level& level = m_levels[level_idx];
+            for (uint64_t block = (first + size - 1) >> shift; block < block_end; ++block) {
+                size_t pos = size_t(block % level.min.size());
+                if (level_idx == 0) {
+                    Level const& from_level = from.m_levels[0];
+                    size_t from_pos = size_t(block % from_level.min.size());
+                    level.min[pos] = from_level.min[from_pos];
+                    level.max[pos] = from_level.max[from_pos];
+                } else {
+                    double lo = INFINITY;
+                    double hi = -INFINITY;
+                    widen(m_levels[level_idx - 1], 2 * block, lo, hi);
+                    widen(m_levels[level_idx - 1], 2 * block + 1, lo, hi);
+                    level.min[pos] = lo;
+                    level.max[pos] = hi;
+                }
+            }
+        }
+    }
+
+  private:
+    static constexpr uint64_t NO_BLOCK = UINT64_MAX;
+
+    struct Level {
+        std::vector<double> min;
+        std::vector<double> max;
+        // Block being collected
+        uint64_t pending_block = NO_BLOCK;
+        double pending_min = INFINITY;
+        double pending_max = -INFINITY;
+    };
+
+    static void widen(Level const& level, uint64_t block, double& min, double& max) {
+        size_t pos = size_t(block % level.min.size());
+        min = MIN(level.min[pos], min);
+        max = MAX(level.max[pos], max);
+    }
+
+    void startBlock(size_t level_idx, uint64_t block) {
+        Level& level = m_levels[level_idx];
+        if (level.pending_block != NO_BLOCK) {
+            // Samples were skipped so the block is written with what it has
+            flush(level_idx);
+        }
+        level.pending_block = block;
+        level.pending_min = INFINITY;
+        level.pending_max = -INFINITY;
+    }
+
+    void flush(size_t level_idx) {
+        Level& level = m_levels[level_idx];
+        uint64_t block = level.pending_block;
+        // Same sign of zero as the min/max kernels
+        double lo = level.pending_min == 0 ? 0.0 : level.pending_min;
+        double hi = level.pending_max == 0 ? 0.0 : level.pending_max;
+        size_t pos = size_t(block % level.min.size());
+        level.min[pos] = lo;
+        level.max[pos] = hi;
+        level.pending_block = NO_BLOCK;
+        if (level_idx + 1 < m_levels.size()) {
+            Level& parent = m_levels[level_idx + 1];
+            if (parent.pending_block != block >> 1) {
+                startBlock(level_idx + 1, block >> 1);
+            }
+            parent.pending_min = MIN(lo, parent.pending_min);
+            parent.pending_max = MAX(hi, parent.pending_max);
+            if (block & 1) {
+                flush(level_idx + 1);
+            }
+        }
+    }
+
+    std::vector<Level> m_levels;
+    uint64_t m_next = 0;
+};
@@ -0,0 +1,109 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include "DbgGui/dbg_gui.h"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+// Paces sampling so that sample time advances at the requested speed relative
+// to the wall clock. Targets are computed from a fixed base point so that
+// wake-up errors do not accumulate. The calling thread sleeps until shortly
+// before the target and yields for the rest because sleeps are much coarser
+// than the sync interval on some systems.
+class PacingClock {
+  public:
+    // Starts a new base point, e.g. after a pause or a jump in sample time
+    void restart(double time) {
+        m_base_wall = Clock::now();
+        m_base_time = time;
+        m_started = true;
+    }
+
+    // Waits until the wall clock has caught up with time at the given speed
+    void waitUntil(double time, double speed) {
+        if (!m_started || speed != m_speed) {
+            m_speed = speed;
+            restart(time);
+            return;
+        }
+        Clock::time_point const target = m_base_wall + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>((time - m_base_time) / speed));
+        if (Clock::now() - target > MAX_LAG) {
+            // Sampling cannot keep up with the requested speed. Continue from
+            // here instead of running in a burst to catch up.
+            recordError(Clock::now() - target);
+            restart(time);
+            return;
+        }
+        if (target - Clock::now() > SPIN_TIME) {
+            std::this_thread::sleep_until(target - SPIN_TIME);
+        }
+        while (Clock::now() < target) {
+            std::this_thread::yield();
+        }
+        recordError(Clock::now() - target);
+    }
+
+    // Statistics of how late the waits ended during the previous second
+    DbgGui_PacingStatistics statistics() {
+        std::scoped_lock lock(m_statistics_mutex);
+        return m_statistics;
+    }
+
+  private:
+    using Clock = std::chrono::steady_clock;
+    // Sleeps shorter than this are done by yielding
+    static constexpr std::chrono::microseconds SPIN_TIME{1000};
+    static constexpr std::chrono::milliseconds MAX_LAG{100};
+    static constexpr std::chrono::seconds STATISTICS_WINDOW{1};
+
+    void recordError(Clock::duration error) {
+        double const error_s = std::chrono::duration<double>(error).count();
+        ++m_window.sync_count;
+        // Sum until the window is complete
+        m_window.mean_error += error_s;
+        m_window.max_error = std::max(m_window.max_error, error_s);
+
+        Clock::time_point const now = Clock::now();
+        if (now - m_window_start >= STATISTICS_WINDOW) {
+            m_window.mean_error /= double(m_window.sync_count);
+            {
+                std::scoped_lock lock(m_statistics_mutex);
+                m_statistics = m_window;
+            }
+            m_window = {};
+            m_window_start = now;
+        }
+    }
+
+    Clock::time_point m_base_wall;
+    double m_base_time = 0;
+    double m_speed = 1;
+    bool m_started = false;
+    Clock::time_point m_window_start = Clock::now();
+    DbgGui_PacingStatistics m_window{};
+    std::mutex m_statistics_mutex;
+    DbgGui_PacingStatistics m_statistics{};
+};
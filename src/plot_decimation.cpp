@@ -23,6 +23,7 @@
 #include "plot_decimation.h"
 
 #include "minmax.h"
+#include "minmax_kernel.h"
 
 #include <algorithm>
 #include <cmath>
@@ -49,18 +50,20 @@ std::pair<double, double> transformMinMax(double y_min, double y_max, Decimation
     return {transformed_max, transformed_min};
 }
 
-} // namespace
-
-DecimatedValues decimateValues(std::span<double const> x,
-                               std::span<double const> y,
-                               int count,
-                               DecimationTransform transform) {
+// Splits samples [0, sample_count) into buckets. time(i) returns the x value
+// of sample i and min_max(begin, end, min, max) widens min and max with the
+// samples [begin, end).
+template <typename Time, typename MinMaxOf>
+DecimatedValues decimateBuckets(Time const& time,
+                                size_t sample_count,
+                                int count,
+                                DecimationTransform const& transform,
+                                MinMaxOf const& min_max) {
     DecimatedValues decimated_values;
-    if (x.empty() || y.empty()) {
+    if (sample_count == 0) {
         return decimated_values;
     }
 
-    size_t sample_count = MIN(x.size(), y.size());
     if (count != ALL_SAMPLES) {
         count = std::clamp(count, MIN_PLOT_SAMPLE_COUNT, MAX_PLOT_SAMPLE_COUNT);
     }
@@ -78,23 +81,60 @@ DecimatedValues decimateValues(std::span<double const> x,
 
         double current_min = std::numeric_limits<double>::infinity();
         double current_max = -std::numeric_limits<double>::infinity();
-        for (size_t i = begin; i < end; ++i) {
-            current_min = MIN(y[i], current_min);
-            current_max = MAX(y[i], current_max);
-        }
+        min_max(begin, end, current_min, current_max);
+        appendBucket(decimated_values, 0.5 * (time(begin) + time(end - 1)), current_min, current_max, transform);
+    }
+    return decimated_values;
+}
 
-        if (current_min > current_max) {
-            current_min = std::numeric_limits<double>::quiet_NaN();
-            current_max = std::numeric_limits<double>::quiet_NaN();
-        }
+template <typename Time, typename T>
+DecimatedValues decimateSamples(Time const& time,
+                                size_t time_count,
+                                RingSpan<T> y,
+                                size_t valid_begin,
+                                int count,
+                                DecimationTransform const& transform) {
+    return decimateBuckets(time, MIN(time_count, y.size()), count, transform, [&](size_t begin, size_t end, double& current_min, double& current_max) {
+        y.forEachSegment(MIN(MAX(begin, valid_begin), end), end, [&](std::span<T const> segment) {
+            minMaxOf(segment, current_min, current_max);
+        });
+    });
+}
 
-        double x_center = 0.5 * (x[begin] + x[end - 1]);
-        auto [y_min, y_max] = transformMinMax(current_min, current_max, transform);
-        decimated_values.x.push_back(transformX(x_center, transform));
-        decimated_values.y_min.push_back(y_min);
-        decimated_values.y_max.push_back(y_max);
+// Runs are reduced whole so a bucket costs one step per run instead of per sample
+template <typename Time>
+DecimatedValues decimateSamples(Time const& time,
+                                size_t time_count,
+                                RunSpan y,
+                                size_t valid_begin,
+                                int count,
+                                DecimationTransform const& transform) {
+    return decimateBuckets(time, MIN(time_count, y.size()), count, transform, [&](size_t begin, size_t end, double& current_min, double& current_max) {
+        y.forEachRun(MIN(MAX(begin, valid_begin), end), end, [&](size_t, size_t, double value) {
+            current_min = MIN(value, current_min);
+            current_max = MAX(value, current_max);
+        });
+    });
+}
+
+} // namespace
+
+void appendBucket(DecimatedValues& values, double x, double y_min, double y_max, DecimationTransform const& transform) {
+    if (y_min > y_max) {
+        y_min = std::numeric_limits<double>::quiet_NaN();
+        y_max = std::numeric_limits<double>::quiet_NaN();
     }
-    return decimated_values;
+    auto [transformed_min, transformed_max] = transformMinMax(y_min, y_max, transform);
+    values.x.push_back(transformX(x, transform));
+    values.y_min.push_back(transformed_min);
+    values.y_max.push_back(transformed_max);
+}
+
+DecimatedValues decimateValues(std::span<double const> x,
+                               std::span<double const> y,
+                               int count,
+                               DecimationTransform transform) {
+    return decimateSamples([&](size_t i) { return x[i]; }, x.size(), RingSpan<double>(y), 0, count, transform);
 }
 
 DecimatedValues decimateValues(std::span<double const> x,
@@ -114,3 +154,40 @@ DecimatedValues decimateValues(std::span<double const> x,
                           count,
                           transform);
 }
+
+DecimatedValues decimateValues(std::function<double(size_t)> const& time,
+                               SampleView y,
+                               int count,
+                               DecimationTransform transform) {
+    return std::visit(
+      [&](auto const& values) { return decimateSamples(time, values.size(), values, y.valid_begin, count, transform); },
+      y.values);
+}
+
+DecimatedValues decimateRanges(std::function<double(size_t)> const& time,
+                               size_t sample_count,
+                               std::function<void(size_t, size_t, double&, double&)> const& min_max,
+                               int count,
+                               DecimationTransform transform) {
+    return decimateBuckets(time, sample_count, count, transform, min_max);
+}
+
+DecimatedValues decimateMinMax(std::function<double(size_t)> const& time,
+                               RingSpan<double> y_min,
+                               RingSpan<double> y_max,
+                               int count,
+                               DecimationTransform transform) {
+    size_t sample_count = MIN(y_min.size(), y_max.size());
+    return decimateBuckets(time, sample_count, count, transform, [&](size_t begin, size_t end, double& current_min, double& current_max) {
+        y_min.forEachSegment(begin, end, [&](std::span<double const> segment) {
+            for (double value : segment) {
+                current_min = MIN(value, current_min);
+            }
+        });
+        y_max.forEachSegment(begin, end, [&](std::span<double const> segment) {
+            for (double value : segment) {
+                current_max = MAX(value, current_max);
+            }
+        });
+    });
+}
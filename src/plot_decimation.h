@@ -21,8 +21,13 @@
 // SOFTWARE.
 #pragma once
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <span>
+#include <variant>
 #include <vector>
 
 struct DecimatedValues {
@@ -38,10 +43,138 @@ struct DecimationTransform {
     double y_offset = 0;
 };
 
+// Contiguous range of a ring buffer. The range continues from the start of
+// the storage if it wraps around the end, so it is at most two spans.
+template <typename T>
+struct RingSpan {
+    std::span<T const> head;
+    std::span<T const> tail;
+
+    RingSpan() = default;
+    RingSpan(std::span<T const> head_, std::span<T const> tail_ = {})
+        : head(head_),
+          tail(tail_) {}
+
+    // count items of ring starting from index start of the storage
+    static RingSpan fromRing(std::span<T const> ring, size_t start, size_t count) {
+        if (ring.empty() || count == 0) {
+            return {};
+        }
+        start %= ring.size();
+        size_t head_count = std::min(count, ring.size() - start);
+        return {ring.subspan(start, head_count), ring.first(std::min(count - head_count, start))};
+    }
+
+    size_t size() const {
+        return head.size() + tail.size();
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    T const& operator[](size_t i) const {
+        return i < head.size() ? head[i] : tail[i - head.size()];
+    }
+
+    RingSpan subspan(size_t offset, size_t count) const {
+        if (offset >= head.size()) {
+            return {tail.subspan(offset - head.size(), count)};
+        }
+        size_t head_count = std::min(count, head.size() - offset);
+        return {head.subspan(offset, head_count), tail.first(count - head_count)};
+    }
+
+    // Calls fn with the contiguous pieces of items [begin, end)
+    template <typename Fn>
+    void forEachSegment(size_t begin, size_t end, Fn&& fn) const {
+        if (begin < head.size()) {
+            fn(head.subspan(begin, std::min(end, head.size()) - begin));
+        }
+        if (end > head.size()) {
+            size_t tail_begin = std::max(begin, head.size()) - head.size();
+            fn(tail.subspan(tail_begin, end - head.size() - tail_begin));
+        }
+    }
+
+    template <typename OutputIt>
+    OutputIt copyTo(OutputIt out) const {
+        out = std::copy(head.begin(), head.end(), out);
+        return std::copy(tail.begin(), tail.end(), out);
+    }
+};
+
+// Samples of a slowly changing signal stored only where the value changes.
+// Run r holds values[r] from sample starts[r] until the start of the next run.
+// Sample i of the span is sample first + i of the run numbering. Samples
+// before the first run are not stored.
+struct RunSpan {
+    std::span<uint64_t const> starts;
+    std::span<double const> values;
+    uint64_t first = 0;
+    size_t count = 0;
+
+    size_t size() const {
+        return count;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    double operator[](size_t i) const {
+        double value = NAN;
+        forEachRun(i, i + 1, [&](size_t, size_t, double run_value) { value = run_value; });
+        return value;
+    }
+
+    // Calls fn(run_begin, run_end, value) for the parts of the runs that
+    // overlap samples [begin, end)
+    template <typename Fn>
+    void forEachRun(size_t begin, size_t end, Fn&& fn) const {
+        uint64_t sample = first + begin;
+        uint64_t stop = first + end;
+        size_t run = size_t(std::upper_bound(starts.begin(), starts.end(), sample) - starts.begin());
+        if (run == 0) {
+            if (starts.empty() || starts.front() >= stop) {
+                return;
+            }
+            sample = starts.front();
+        } else {
+            --run;
+        }
+        for (; run < starts.size() && sample < stop; ++run) {
+            uint64_t run_end = run + 1 < starts.size() ? std::min(starts[run + 1], stop) : stop;
+            fn(size_t(sample - first), size_t(run_end - first), values[run]);
+            sample = run_end;
+        }
+    }
+};
+
+// Samples stored in their native width or as runs. Samples before valid_begin
+// were never sampled and are treated as NAN.
+struct SampleView {
+    std::variant<RingSpan<int8_t>,
+                 RingSpan<int16_t>,
+                 RingSpan<int32_t>,
+                 RingSpan<uint8_t>,
+                 RingSpan<uint16_t>,
+                 RingSpan<uint32_t>,
+                 RingSpan<float>,
+                 RingSpan<double>,
+                 RunSpan>
+      values;
+    size_t valid_begin = 0;
+};
+
 inline constexpr int MIN_PLOT_SAMPLE_COUNT = 128;
 inline constexpr int MAX_PLOT_SAMPLE_COUNT = 10'000;
 inline constexpr int ALL_SAMPLES = -1;
 
+// Appends a bucket whose min and max are not transformed yet. A bucket without
+// samples has min > max and is appended as NAN.
+void appendBucket(DecimatedValues& values, double x, double y_min, double y_max, DecimationTransform const& transform);
+
 DecimatedValues decimateValues(std::span<double const> x,
                                std::span<double const> y,
                                int count,
@@ -52,3 +185,24 @@ DecimatedValues decimateValues(std::span<double const> x,
                                size_t end_idx,
                                int count,
                                DecimationTransform transform = {});
+// Decimates samples whose x values are not stored. time(i) returns the x
+// value of sample i of y.
+DecimatedValues decimateValues(std::function<double(size_t)> const& time,
+                               SampleView y,
+                               int count,
+                               DecimationTransform transform = {});
+// Decimates samples whose min/max over samples [begin, end) is given by
+// min_max(begin, end, min, max), e.g. from precomputed block summaries.
+// time(i) returns the x value of sample i.
+DecimatedValues decimateRanges(std::function<double(size_t)> const& time,
+                               size_t sample_count,
+                               std::function<void(size_t, size_t, double&, double&)> const& min_max,
+                               int count,
+                               DecimationTransform transform = {});
+// Decimates ranges that are already reduced to min/max pairs, e.g. coarse
+// history. time(i) returns the x value of pair i.
+DecimatedValues decimateMinMax(std::function<double(size_t)> const& time,
+                               RingSpan<double> y_min,
+                               RingSpan<double> y_max,
+                               int count,
+                               DecimationTransform transform = {});
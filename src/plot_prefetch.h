@@ -0,0 +1,136 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include "plot_decimation.h"
+#include "worker_pool.h"
+
+#include <functional>
+#include <map>
+#include <utility>
+#include <vector>
+
+// Decimation of the plots of a frame done in parallel before the plots are
+// drawn. The plot ranges are only known while drawing so the requests are
+// predicted from the previous frame. A plot takes the prepared values only if
+// it asks for exactly the predicted ones and decimates by itself otherwise,
+// e.g. while the plot is zoomed or resized.
+//
+// With start() the requests of the next frame are decimated in the background
+// while the current frame is rendered, which delays the plotted data by a
+// frame. Anything the requests read must be left alone until wait().
+class PlotPrefetch {
+  public:
+    struct Request {
+        void const* plot;
+        void const* signal;
+        double start;
+        double end;
+        int count;
+        DecimationTransform transform;
+
+        bool operator==(Request const& other) const {
+            return plot == other.plot
+                && signal == other.signal
+                && start == other.start
+                && end == other.end
+                && count == other.count
+                && transform.x_scale == other.transform.x_scale
+                && transform.x_offset == other.transform.x_offset
+                && transform.y_scale == other.transform.y_scale
+                && transform.y_offset == other.transform.y_offset;
+        }
+    };
+
+    // The pool of start() must outlive the prefetch
+    ~PlotPrefetch() {
+        wait();
+    }
+
+    // decimate is called from the threads of the pool so it may only read
+    // data that is not changed before the values are prepared
+    void add(Request const& request, std::function<DecimatedValues()> decimate) {
+        m_jobs.push_back({request, std::move(decimate), {}});
+    }
+
+    // Starts decimating the added requests on the pool and returns right away.
+    // The pool must not be used for anything else until wait().
+    void start(WorkerPool& pool) {
+        wait();
+        m_running = std::move(m_jobs);
+        m_jobs.clear();
+        if (m_running.empty()) {
+            m_prepared.clear();
+            return;
+        }
+        m_pool = &pool;
+        m_pool->start(m_running.size(), [this](size_t i) {
+            m_running[i].values = m_running[i].decimate();
+        });
+    }
+
+    // Waits until the requests of start() are decimated. Their values replace
+    // the values that were not taken.
+    void wait() {
+        if (m_pool == nullptr) {
+            return;
+        }
+        m_pool->wait();
+        m_pool = nullptr;
+        m_prepared.clear();
+        for (Job& job : m_running) {
+            m_prepared.insert_or_assign({job.request.plot, job.request.signal}, std::move(job));
+        }
+        m_running.clear();
+    }
+
+    // Decimates the added requests and waits for them
+    void prepare(WorkerPool& pool) {
+        start(pool);
+        wait();
+    }
+
+    // Prepared values of the request or decimate() if the request was not
+    // predicted
+    template <typename Decimate>
+    DecimatedValues take(Request const& request, Decimate&& decimate) {
+        auto it = m_prepared.find({request.plot, request.signal});
+        if (it == m_prepared.end() || !(it->second.request == request)) {
+            return decimate();
+        }
+        DecimatedValues values = std::move(it->second.values);
+        m_prepared.erase(it);
+        return values;
+    }
+
+  private:
+    struct Job {
+        Request request;
+        std::function<DecimatedValues()> decimate;
+        DecimatedValues values;
+    };
+
+    std::vector<Job> m_jobs;
+    std::vector<Job> m_running;
+    WorkerPool* m_pool = nullptr;
+    std::map<std::pair<void const*, void const*>, Job> m_prepared;
+};
@@ -0,0 +1,193 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum class ProfileSection {
+    // Sampling thread
+    SamplingLockWait,
+    Scripts,
+    Sampling,
+    PauseTriggers,
+    SpeedSync,
+    // GUI thread
+    Frame,
+    PauseWait,
+    DrainSamples,
+    PreparePlots,
+    MainMenuBar,
+    LogWindow,
+    CaptureWindow,
+    ScalarWindow,
+    VectorWindow,
+    CustomWindow,
+    SymbolsWindow,
+    ScriptWindow,
+    GridWindow,
+    ScalarPlots,
+    VectorPlots,
+    SpectrumPlots,
+    Rendering,
+    Count,
+};
+
+inline constexpr std::array<char const*, size_t(ProfileSection::Count)> PROFILE_SECTION_NAMES = {
+  "Sampling lock wait",
+  "Scripts",
+  "Sampling",
+  "Pause triggers",
+  "Speed sync",
+  "Frame",
+  "Pause wait",
+  "Drain samples",
+  "Wait for prepared plots",
+  "Main menu bar",
+  "Log window",
+  "Capture window",
+  "Scalar window",
+  "Vector window",
+  "Custom window",
+  "Symbols window",
+  "Script window",
+  "Grid window",
+  "Scalar plots",
+  "Vector plots",
+  "Spectrum plots",
+  "Rendering",
+};
+
+// Low overhead timing of DbgGui's own work. Each section is written by one
+// thread and can be read from any thread. Timing is skipped entirely while
+// disabled so that the sampling thread only pays for one relaxed load.
+class Profiler {
+  public:
+    using Clock = std::chrono::steady_clock;
+    // Number of the newest durations kept per section for histograms
+    static constexpr size_t HISTORY_SIZE = 1024;
+
+    struct Totals {
+        uint64_t count;
+        // Seconds
+        double total_time;
+        double max_time;
+    };
+
+    void setEnabled(bool enabled) {
+        m_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool enabled() const {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    void record(ProfileSection section, Clock::duration duration) {
+        Counters& counters = m_sections[size_t(section)];
+        uint64_t const ns = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+        uint64_t const count = counters.count.load(std::memory_order_relaxed);
+        counters.history[count % HISTORY_SIZE].store(float(ns * 1e-3), std::memory_order_relaxed);
+        counters.total_ns.store(counters.total_ns.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+        if (ns > counters.max_ns.load(std::memory_order_relaxed)) {
+            counters.max_ns.store(ns, std::memory_order_relaxed);
+        }
+        counters.count.store(count + 1, std::memory_order_release);
+    }
+
+    Totals totals(ProfileSection section) const {
+        Counters const& counters = m_sections[size_t(section)];
+        return {counters.count.load(std::memory_order_acquire),
+                double(counters.total_ns.load(std::memory_order_relaxed)) * 1e-9,
+                double(counters.max_ns.load(std::memory_order_relaxed)) * 1e-9};
+    }
+
+    // Newest durations in microseconds from the oldest to the newest
+    std::vector<float> history(ProfileSection section) const {
+        Counters const& counters = m_sections[size_t(section)];
+        uint64_t const count = counters.count.load(std::memory_order_acquire);
+        size_t const size = size_t(std::min<uint64_t>(count, HISTORY_SIZE));
+        std::vector<float> durations;
+        durations.reserve(size);
+        for (uint64_t i = count - size; i < count; ++i) {
+            durations.push_back(counters.history[i % HISTORY_SIZE].load(std::memory_order_relaxed));
+        }
+        return durations;
+    }
+
+    // Not synchronized with writers so some in-flight measurements may remain
+    void reset() {
+        for (Counters& counters : m_sections) {
+            counters.count = 0;
+            counters.total_ns = 0;
+            counters.max_ns = 0;
+        }
+    }
+
+  private:
+    struct Counters {
+        std::atomic<uint64_t> count = 0;
+        std::atomic<uint64_t> total_ns = 0;
+        std::atomic<uint64_t> max_ns = 0;
+        std::array<std::atomic<float>, HISTORY_SIZE> history{};
+    };
+
+    std::atomic<bool> m_enabled = false;
+    std::array<Counters, size_t(ProfileSection::Count)> m_sections;
+};
+
+// Records the time from construction to stop() or destruction
+class ProfileScope {
+  public:
+    ProfileScope(Profiler& profiler, ProfileSection section)
+        : m_profiler(profiler),
+          m_section(section),
+          m_running(profiler.enabled()) {
+        if (m_running) {
+            m_start = Profiler::Clock::now();
+        }
+    }
+
+    ~ProfileScope() {
+        stop();
+    }
+
+    ProfileScope(ProfileScope const&) = delete;
+    ProfileScope& operator=(ProfileScope const&) = delete;
+
+    void stop() {
+        if (m_running) {
+            m_profiler.record(m_section, Profiler::Clock::now() - m_start);
+            m_running = false;
+        }
+    }
+
+  private:
+    Profiler& m_profiler;
+    ProfileSection m_section;
+    bool m_running;
+    Profiler::Clock::time_point m_start;
+};
@@ -0,0 +1,102 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+// Single-producer/single-consumer ring of fixed width sample rows. The sampling
+// thread writes a row and publishes it by advancing the write cursor; the GUI
+// thread reads committed rows and publishes the read cursor. Neither side ever
+// waits for the other, so a full ring rejects the row instead of blocking.
+class SampleRing {
+  public:
+    SampleRing(size_t row_capacity, size_t row_width)
+        : m_capacity(std::bit_ceil(std::max<size_t>(row_capacity, 1))),
+          m_row_width(row_width),
+          m_data(m_capacity * row_width) {}
+
+    SampleRing(SampleRing const&) = delete;
+    SampleRing& operator=(SampleRing const&) = delete;
+
+    // Producer: returns the row to fill or nullptr if the consumer has fallen
+    // a full ring behind. The row becomes visible only after commitWrite().
+    double* beginWrite() {
+        size_t write = m_write.load(std::memory_order_relaxed);
+        if (write - m_read_cached >= m_capacity) {
+            m_read_cached = m_read.load(std::memory_order_acquire);
+            if (write - m_read_cached >= m_capacity) {
+                return nullptr;
+            }
+        }
+        return rowAt(write);
+    }
+
+    void commitWrite() {
+        m_write.store(m_write.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Consumer: calls fn for every committed row in order and then releases
+    // the rows back to the producer.
+    template <typename Fn>
+    size_t drain(Fn&& fn) {
+        size_t read = m_read.load(std::memory_order_relaxed);
+        size_t write = m_write.load(std::memory_order_acquire);
+        size_t count = write - read;
+        for (; read != write; ++read) {
+            fn(std::span<double const>(rowAt(read), m_row_width));
+        }
+        m_read.store(read, std::memory_order_release);
+        return count;
+    }
+
+    // Number of committed rows not yet drained. Exact only on the consumer side.
+    size_t size() const {
+        return m_write.load(std::memory_order_acquire) - m_read.load(std::memory_order_relaxed);
+    }
+
+    size_t capacity() const {
+        return m_capacity;
+    }
+
+    size_t rowWidth() const {
+        return m_row_width;
+    }
+
+  private:
+    double* rowAt(size_t cursor) {
+        return m_data.data() + (cursor & (m_capacity - 1)) * m_row_width;
+    }
+
+    size_t const m_capacity;
+    size_t const m_row_width;
+    std::vector<double> m_data;
+    // Cursors are on separate cache lines so that the producer and consumer do
+    // not invalidate each other's line on every row.
+    alignas(64) std::atomic<size_t> m_write = 0;
+    size_t m_read_cached = 0; // Producer's last seen read cursor
+    alignas(64) std::atomic<size_t> m_read = 0;
+};
@@ -0,0 +1,76 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include "data_structures.h"
+#include "scrolling_buffer.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+struct DbgGui_SamplingDomain {
+    std::string name;
+    ScrollingBuffer sampler;
+    // Only accessed by the thread sampling the domain
+    double sample_timestamp = 0;
+};
+
+// Buffer of the sampling domain of the scalar
+inline ScrollingBuffer& domainSampler(Scalar const* scalar, ScrollingBuffer& main_sampler) {
+    return scalar->sampling_domain ? scalar->sampling_domain->sampler : main_sampler;
+}
+
+// Moves the scalar to the domain or to the main sampling with nullptr. The
+// components of a vector are plotted against each other sample by sample so
+// they move together with every vector they are in. Samples from the old time
+// base are not kept.
+inline void setSamplingDomain(Scalar* scalar,
+                              DbgGui_SamplingDomain* domain,
+                              ScrollingBuffer& main_sampler,
+                              std::vector<std::unique_ptr<Vector2D>> const& vectors) {
+    std::vector<Scalar*> moved{scalar};
+    for (size_t i = 0; i < moved.size(); ++i) {
+        for (std::unique_ptr<Vector2D> const& vector : vectors) {
+            if (vector->x == moved[i] || vector->y == moved[i]) {
+                for (Scalar* component : {vector->x, vector->y}) {
+                    if (!contains(moved, component)) {
+                        moved.push_back(component);
+                    }
+                }
+            }
+        }
+    }
+    for (Scalar* component : moved) {
+        if (component->sampling_domain == domain) {
+            continue;
+        }
+        bool sampled = domainSampler(component, main_sampler).isScalarSampled(component);
+        if (sampled) {
+            domainSampler(component, main_sampler).stopSampling(component);
+        }
+        component->sampling_domain = domain;
+        if (sampled) {
+            domainSampler(component, main_sampler).startSampling(component);
+        }
+    }
+}
@@ -0,0 +1,115 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+// Handshake between the GUI and the sampling threads. The GUI pauses the
+// sampling to access sampled data and symbols. The main sampling thread
+// acknowledges the pause when it starts waiting and the threads of the
+// sampling domains are counted while they sample, so pauseSampling() returns
+// only after every sampling thread has stopped.
+class SamplingPause {
+  public:
+    explicit SamplingPause(std::atomic<bool>& paused)
+        : m_paused(paused) {
+    }
+
+    // Wakes up the threads waiting for the paused state to change
+    void setPaused(bool paused) {
+        {
+            // Written under the lock so that a waiting thread cannot miss the change
+            std::scoped_lock lock(m_mutex);
+            m_paused = paused;
+        }
+        m_cv.notify_all();
+    }
+
+    // Pauses and waits until the sampling threads have stopped. Returns the
+    // previous paused state to be restored with setPaused().
+    bool pauseSampling() {
+        std::unique_lock lock(m_mutex);
+        bool const paused = m_paused;
+        m_paused = true;
+        m_cv.wait(lock, [this] { return m_sampling_paused && m_active_domain_samples == 0; });
+        return paused;
+    }
+
+    // Waits until resumed if paused. Only the thread that does the main
+    // sampling acknowledges the pause. Another thread, e.g. the application
+    // while a background thread samples, must not tell the GUI that the
+    // sampling has stopped.
+    void waitWhilePaused(bool acknowledge = true) {
+        std::unique_lock lock(m_mutex);
+        while (m_paused) {
+            if (acknowledge) {
+                // Sampled data and symbols can be accessed
+                m_sampling_paused = true;
+                m_cv.notify_all();
+            }
+            m_cv.wait(lock);
+        }
+        if (acknowledge) {
+            m_sampling_paused = false;
+        }
+    }
+
+    // Pauses and waits until resumed
+    void pause(bool acknowledge = true) {
+        m_paused = true;
+        waitWhilePaused(acknowledge);
+    }
+
+    // Called from the thread of a sampling domain. Waits until resumed if
+    // paused and then calls sample().
+    template <typename Sample>
+    void sampleDomain(Sample&& sample) {
+        // Counted before the pause is checked so that either pauseSampling()
+        // sees the count or this thread sees the pause
+        ++m_active_domain_samples;
+        while (m_paused) {
+            std::unique_lock lock(m_mutex);
+            --m_active_domain_samples;
+            m_cv.notify_all();
+            m_cv.wait(lock, [this] { return !m_paused; });
+            ++m_active_domain_samples;
+        }
+        sample();
+        --m_active_domain_samples;
+        if (m_paused) {
+            std::scoped_lock lock(m_mutex);
+            m_cv.notify_all();
+        }
+    }
+
+  private:
+    std::atomic<bool>& m_paused;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    // Set by the main sampling thread while it waits for resume. Guarded by
+    // m_mutex. Sampling has not started yet initially.
+    bool m_sampling_paused = true;
+    std::atomic<size_t> m_active_domain_samples = 0;
+};
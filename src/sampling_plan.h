@@ -0,0 +1,127 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include "data_structures.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+// Address that the source reads from or nullptr for callables, e.g. to find
+// the source of a sample block
+inline void const* valueSourceAddress(ValueSource const& src) {
+    return std::visit(
+      [](auto const& src) -> void const* {
+          if constexpr (std::is_pointer_v<std::decay_t<decltype(src)>>) {
+              return src;
+          } else {
+              return nullptr;
+          }
+      },
+      src);
+}
+
+// Precompiled read of a set of value sources. Plain pointers are grouped by
+// their type so that sampling them is a tight loop per type without visiting
+// the variant. Callables are left on the slow path.
+//
+// The plan reorders the sources so that every group fills a contiguous range
+// of the output. order()[i] is the index of the source written to values[i].
+class SamplingPlan {
+  public:
+    SamplingPlan() = default;
+
+    explicit SamplingPlan(std::span<ValueSource const> sources) {
+        for (size_t i = 0; i < sources.size(); ++i) {
+            std::visit(
+              [&](auto const& src) {
+                  using T = std::decay_t<decltype(src)>;
+                  if constexpr (std::is_pointer_v<T>) {
+                      auto& bucket = std::get<Bucket<std::remove_pointer_t<T>>>(m_buckets);
+                      bucket.sources.push_back(src);
+                      bucket.indices.push_back(i);
+                  } else {
+                      m_callables.push_back(src);
+                      m_callable_indices.push_back(i);
+                  }
+              },
+              sources[i]);
+        }
+
+        m_order.reserve(sources.size());
+        std::apply([&](auto const&... bucket) { (m_order.insert(m_order.end(), bucket.indices.begin(), bucket.indices.end()), ...); },
+                   m_buckets);
+        m_order.insert(m_order.end(), m_callable_indices.begin(), m_callable_indices.end());
+    }
+
+    // Writes size() values in the order given by order()
+    void gather(double* values) const {
+        std::apply([&](auto const&... bucket) { ((values = gatherBucket(bucket, values)), ...); }, m_buckets);
+        for (ValueSource const& src : m_callables) {
+            *values++ = getSourceValue(src);
+        }
+    }
+
+    std::vector<size_t> const& order() const {
+        return m_order;
+    }
+
+    size_t size() const {
+        return m_order.size();
+    }
+
+  private:
+    template <typename T>
+    struct Bucket {
+        std::vector<T*> sources;
+        std::vector<size_t> indices;
+    };
+
+    template <typename T>
+    static double* gatherBucket(Bucket<T> const& bucket, double* values) {
+        T* const* sources = bucket.sources.data();
+        size_t const count = bucket.sources.size();
+        for (size_t i = 0; i < count; ++i) {
+            values[i] = static_cast<double>(*sources[i]);
+        }
+        return values + count;
+    }
+
+    std::tuple<Bucket<int8_t>,
+               Bucket<int16_t>,
+               Bucket<int32_t>,
+               Bucket<int64_t>,
+               Bucket<uint8_t>,
+               Bucket<uint16_t>,
+               Bucket<uint32_t>,
+               Bucket<uint64_t>,
+               Bucket<float>,
+               Bucket<double>>
+      m_buckets;
+    std::vector<ValueSource> m_callables;
+    std::vector<size_t> m_callable_indices;
+    std::vector<size_t> m_order;
+};
@@ -22,106 +22,240 @@
 
 #pragma once
 
+#include "DbgGui/dbg_gui.h"
 #include "data_structures.h"
+#include "decimation_cache.h"
+#include "history_file.h"
+#include "history_tiers.h"
+#include "minmax_kernel.h"
+#include "minmax_pyramid.h"
 #include "plot_decimation.h"
+#include "sample_ring.h"
+#include "sampling_plan.h"
+#include "time_axis.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <format>
+#include <iterator>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
 
 // utility structure for realtime plot
+//
+// sample(), sampleBatch() and shiftTime() are the only functions called from the sampling
+// thread. They write committed rows into the lock-free ring of the newest
+// sampling channel. Everything else is called from the GUI thread, which
+// drains the rows into the history in emptyTempBuffers() and publishes a new
+// channel whenever the set of sampled scalars changes. The getters of
+// decimated values can be called from several threads at once, e.g. to
+// decimate the plots of a frame in parallel, while the GUI thread does not
+// call anything else.
+//
+// The history is a ring that is stored once. Indices from getTimeIndices()
+// run from the oldest sample to the newest without wrapping, so they can be
+// up to twice the buffer size. They are wrapped only when the storage is read.
+// A scalar with a sample divider N is read only on rows that are multiples of
+// N and its column holds only those samples. The rows share the time axis so
+// the samples are aligned with the other scalars without own time columns.
+// Timestamps are not stored per sample but in a TimeAxis that keeps regular
+// sampling as t0 + n * dt. Scalars that rarely change are stored as runs of
+// equal values instead of a column. Samples older than the raw history remain as
+// downsampled min/max in HistoryTiers. Optionally the drained rows are also
+// written to a memory mapped HistoryFile that outlives a crash.
 class ScrollingBuffer {
   public:
     ScrollingBuffer(int32_t buffer_size)
-        : m_buffer_size(buffer_size),
-          m_time(2 * buffer_size) {}
+        : m_buffer_size(buffer_size) {
+        m_tiers.setBufferSize(size_t(buffer_size));
+        publishChannel();
+    }
 
+    // Samples are stored at their row index modulo the column length so the
+    // kept samples move to new positions. New rows go to the new columns right
+    // away and the kept rows are moved from the old columns a step at a time in
+    // emptyTempBuffers() so that a large history does not stall the GUI.
     void setBufferSize(int32_t buffer_size) {
-        // Copy the current data to temp buffer
-        std::vector<double> current_time;
-        if (m_full_buffer_looped) {
-            current_time = std::vector<double>(m_time.begin() + m_idx, m_time.begin() + m_idx + m_buffer_size);
-        } else {
-            current_time = std::vector<double>(m_time.begin(), m_time.begin() + m_idx);
-        }
+        finishResize();
+        m_decimation_caches.clear();
         // Keep newest up to buffer_size, drop oldest if necessary
-        if ((int32_t)current_time.size() > buffer_size) {
-            current_time = std::vector<double>(current_time.end() - buffer_size, current_time.end());
-        }
-
-        // Copy into new time buffer
-        m_time.assign(2 * buffer_size, NAN);
-        for (size_t i = 0; i < current_time.size(); ++i) {
-            m_time[i] = current_time[i];
-            m_time[i + buffer_size] = current_time[i];
+        m_time.popFront(m_time.size() - std::min(m_time.size(), size_t(buffer_size)));
+        m_resize = Resize{.slabs = std::move(m_slabs), .pyramids = {}, .buffer_size = m_buffer_size, .begin = m_time.begin(), .end = m_time.end()};
+        m_buffer_size = buffer_size;
+        m_tiers.setBufferSize(size_t(buffer_size));
+        m_slabs.clear();
+        for (auto& [divider, old_slabs] : m_resize->slabs) {
+            size_t stride = columnStride(divider);
+            forEachSlab(m_slabs[divider], old_slabs, [&](auto& slab, auto const& old_slab) {
+                slab.data.resize(old_slab.column_count * stride);
+                slab.free_columns = old_slab.free_columns;
+                slab.column_count = old_slab.column_count;
+            });
         }
-        m_time.shrink_to_fit();
-
-        // Copy scalar buffers
-        for (auto& [_scalar, buffer] : m_scalar_buffers) {
-            std::vector<double> current_buffer;
-            if (m_full_buffer_looped) {
-                current_buffer = std::vector<double>(buffer.begin() + m_idx, buffer.begin() + m_idx + m_buffer_size);
-            } else {
-                current_buffer = std::vector<double>(buffer.begin(), buffer.begin() + m_idx);
-            }
-            // Keep newest up to buffer_size, drop oldest if necessary
-            if ((int32_t)current_buffer.size() > buffer_size) {
-                current_buffer = std::vector<double>(current_buffer.end() - buffer_size, current_buffer.end());
-            }
-
-            buffer.assign(2 * buffer_size, NAN);
-            for (size_t i = 0; i < current_buffer.size(); ++i) {
-                buffer[i] = current_buffer[i];
-                buffer[i + buffer_size] = current_buffer[i];
+        // The blocks being collected continue in the new pyramids and the
+        // complete blocks are moved together with the rows
+        m_resize->pyramids.resize(m_slots.size());
+        for (size_t slot_idx = 0; slot_idx < m_slots.size(); ++slot_idx) {
+            Slot& slot = m_slots[slot_idx];
+            if (slot.scalar == nullptr || slot.runs) {
+                continue;
             }
-            buffer.shrink_to_fit();
+            MinMaxPyramid& old_pyramid = m_resize->pyramids[slot_idx];
+            old_pyramid = std::move(slot.pyramid);
+            std::visit(
+              [&](auto type) {
+                  using T = typename decltype(type)::type;
+                  size_t old_stride = columnStride(slot.divider, m_resize->buffer_size);
+                  T const* data = std::get<ColumnSlab<T>>(m_resize->slabs[slot.divider]).data.data() + slot.column * old_stride;
+                  auto raw = [&](uint64_t begin, uint64_t end, double& lo, double& hi) {
+                      for (uint64_t k = begin; k < end; ++k) {
+                          double value = static_cast<double>(data[size_t(k % old_stride)]);
+                          lo = MIN(value, lo);
+                          hi = MAX(value, hi);
+                      }
+                  };
+                  slot.pyramid = old_pyramid.resized(columnStride(slot.divider), storedSampleRange(slot).first, raw);
+              },
+              slot.type);
         }
+        continueResize();
+    }
 
-        m_full_buffer_looped = current_time.size() >= buffer_size;
-        m_idx = m_full_buffer_looped ? 0 : current_time.size();
-        m_buffer_size = buffer_size;
+    // True while kept samples are still being moved after setBufferSize()
+    bool resizing() const {
+        return m_resize.has_value();
     }
 
+    // Sampling thread
     void sample(double time) {
-        m_time_temp.push_back(time);
-        for (auto& [scalar, buffer] : m_scalar_buffers_temp) {
-            buffer.push_back(scalar->getValue());
+        SamplingChannel* channel = acquireChannel();
+        double* row = channel->ring.beginWrite();
+        if (row == nullptr) {
+            // The GUI has fallen a full ring behind. Dropping the row keeps the
+            // sampling thread from ever waiting for rendering.
+            m_dropped_samples.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            row[ROW_TIME] = time;
+            row[ROW_TIME_SHIFT] = m_pending_time_shift;
+            m_pending_time_shift = 0;
+            for (RateGroup const& group : channel->groups) {
+                if (group.divider == 1 || m_committed_rows % group.divider == 0) {
+                    group.plan.gather(row + ROW_FIRST_VALUE + group.offset);
+                }
+            }
+            channel->ring.commitWrite();
+            ++m_committed_rows;
         }
+        m_channel_in_use.store(nullptr);
     }
 
-    void shiftTime(double time) {
-        for (double& t : m_time) {
-            t += time;
+    // Sampling thread. Commits one row per timestamp. Sources listed in blocks
+    // take their values from the block and the other sources are read once.
+    void sampleBatch(std::span<double const> times, std::span<DbgGui_SampleBlock const> blocks) {
+        SamplingChannel* channel = acquireChannel();
+        size_t const width = channel->slots.size();
+        m_batch_row.resize(width);
+        for (RateGroup const& group : channel->groups) {
+            group.plan.gather(m_batch_row.data() + group.offset);
         }
-        for (double& t : m_time_temp) {
-            t += time;
+        m_batch_overrides.clear();
+        for (DbgGui_SampleBlock const& block : blocks) {
+            for (size_t i = 0; i < width; ++i) {
+                if (channel->addresses[i] == block.src) {
+                    m_batch_overrides.push_back({i, block.values});
+                }
+            }
         }
+
+        for (size_t t = 0; t < times.size(); ++t) {
+            double* row = channel->ring.beginWrite();
+            if (row == nullptr) {
+                m_dropped_samples.fetch_add(times.size() - t, std::memory_order_relaxed);
+                break;
+            }
+            row[ROW_TIME] = times[t];
+            row[ROW_TIME_SHIFT] = m_pending_time_shift;
+            m_pending_time_shift = 0;
+            double* values = row + ROW_FIRST_VALUE;
+            std::copy_n(m_batch_row.data(), width, values);
+            for (auto const& [idx, block_values] : m_batch_overrides) {
+                values[idx] = block_values[t];
+            }
+            channel->ring.commitWrite();
+            ++m_committed_rows;
+        }
+        m_channel_in_use.store(nullptr);
     }
 
-    void emptyTempBuffers() {
-        // Empty time buffer first
-        int32_t start_idx = m_idx;
-        for (size_t i = 0; i < m_time_temp.size(); ++i) {
-            double time = m_time_temp[i];
-            m_time[m_idx] = time;
-            m_time[m_idx + m_buffer_size] = time;
+    // Sampling thread. The history is owned by the GUI thread so the shift is
+    // carried by the next committed row and applied when that row is drained.
+    void shiftTime(double time) {
+        m_pending_time_shift += time;
+    }
 
-            m_idx = (m_idx + 1) % m_buffer_size;
-            if (m_idx == 0) {
-                m_full_buffer_looped = true;
+    void emptyTempBuffers() {
+        // Channels are drained in publish order so that rows stay in time order
+        // even if the sampling thread switched channels in the middle of a frame.
+        for (size_t i = 0; i < m_channels.size();) {
+            SamplingChannel& channel = *m_channels[i];
+            bool newest = i == m_channels.size() - 1;
+            // A replaced channel can be released once the sampling thread is no
+            // longer inside it. The check must happen before the final drain so
+            // that no row can be committed after it.
+            bool retired = !newest && m_channel_in_use.load() != &channel;
+            drainChannel(channel);
+            if (retired) {
+                m_channels.erase(m_channels.begin() + i);
+            } else {
+                ++i;
             }
         }
-        m_time_temp.clear();
+        updateEncodings();
+        // Buckets of plots that were not drawn since the previous drain
+        ++m_drain_count;
+        std::erase_if(m_decimation_caches, [&](auto const& entry) { return entry.second.used + 1 < m_drain_count; });
 
-        // Empty temp scalar buffers to same indices
-        for (auto& [scalar, buffer] : m_scalar_buffers) {
-            auto& temp_buffer = m_scalar_buffers_temp[scalar];
-            int32_t idx = start_idx;
-            for (size_t i = 0; i < temp_buffer.size(); ++i) {
-                double value = temp_buffer[i];
-                buffer[idx] = value;
-                buffer[idx + m_buffer_size] = value;
-                idx = (idx + 1) % m_buffer_size;
+        size_t dropped = m_dropped_samples.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0) {
+            m_dropped_samples_total += dropped;
+            // Give the sampling thread more room for the next time the GUI stalls
+            if (m_ring_rows < size_t(m_buffer_size)) {
+                m_ring_rows = std::min(2 * m_ring_rows, size_t(m_buffer_size));
+                m_layout_changed = true;
             }
-            temp_buffer.clear();
         }
+        if (m_layout_changed) {
+            publishChannel();
+        }
+        continueResize();
+    }
+
+    // Number of samples dropped since the previous call because the ring was
+    // full when the sampling thread tried to commit a row.
+    size_t takeDroppedSampleCount() {
+        return std::exchange(m_dropped_samples_total, 0);
+    }
+
+    // Error that stopped recording to the history file since the previous call
+    std::optional<std::string> takeHistoryFileError() {
+        return std::exchange(m_history_file_error, std::nullopt);
+    }
+
+    // Timestamp of the newest drained sample
+    double latestTime() const {
+        return m_latest_time;
     }
 
     DecimatedValues getValuesInRange(Scalar* scalar, int32_t start_idx, int32_t end_idx, int32_t n_points, double scale = 1, double offset = 0) {
@@ -134,13 +268,91 @@ class ScrollingBuffer {
             return decimated_values;
         }
 
-        auto const& data = m_scalar_buffers.at(scalar);
-        return decimateValues(m_time,
-                              data,
-                              size_t(start_idx),
-                              size_t(end_idx) + 1,
-                              n_points,
-                              {.y_scale = scale, .y_offset = offset});
+        size_t count = size_t(std::max(end_idx - start_idx + 1, 0));
+        Slot const& slot = m_slots[m_slots_by_scalar.at(scalar)];
+        SlotSamples samples = slotSamples(m_slots_by_scalar.at(scalar), absoluteIndex(size_t(start_idx)), count);
+        auto time = [&](size_t i) { return m_time.at(samples.first_row + i * samples.divider); };
+        DecimationTransform transform{.y_scale = scale, .y_offset = offset};
+        if (n_points == ALL_SAMPLES) {
+            return decimateValues(time, samples.view, n_points, transform);
+        }
+        return withMinMax(slot, samples, [&](auto const& min_max) {
+            return decimateRanges(time, sampleCount(samples.view), min_max, n_points, transform);
+        });
+    }
+
+    // Same as getValuesInRange() for live plots. The buckets are on a grid of
+    // sample indices and kept between frames so that only the buckets that
+    // scrolled into the range are computed. Plots of the same scalar with a
+    // similar number of samples per point share the buckets.
+    DecimatedValues getCachedValuesInRange(Scalar* scalar, std::pair<int32_t, int32_t> times, int32_t n_points, double scale = 1, double offset = 0) {
+        if (n_points == ALL_SAMPLES || times.first < 0 || times.second < 0) {
+            return getValuesInRange(scalar, times, n_points, scale, offset);
+        }
+
+        size_t slot_idx = m_slots_by_scalar.at(scalar);
+        Slot const& slot = m_slots[slot_idx];
+        SlotSamples window = slotSamples(slot_idx, absoluteIndex(size_t(times.first)), size_t(std::max(times.second - times.first + 1, 0)));
+        SlotSamples stored = slotSamples(slot_idx, rawBegin(), size_t(m_time.end() - rawBegin()));
+        uint64_t first = window.first_row / slot.divider;
+        uint64_t stored_first = stored.first_row / slot.divider;
+        uint64_t bucket_size = DecimationCache::bucketSize(sampleCount(window.view), n_points);
+        PlotBuckets* buckets;
+        {
+            std::scoped_lock lock(m_decimation_mutex);
+            buckets = &m_decimation_caches.try_emplace({scalar, bucket_size}, bucket_size).first->second;
+            buckets->used = m_drain_count;
+        }
+        // The same buckets may be plotted from several threads
+        std::scoped_lock lock(buckets->mutex);
+
+        auto time = [&](uint64_t k) { return m_time.at(k * slot.divider); };
+        DecimationTransform transform{.y_scale = scale, .y_offset = offset};
+        return withMinMax(slot, stored, [&](auto const& min_max) {
+            return buckets->cache.decimate(
+              first,
+              first + sampleCount(window.view),
+              stored_first + stored.view.valid_begin,
+              stored_first + sampleCount(stored.view),
+              time,
+              [&](uint64_t begin, uint64_t end, double& lo, double& hi) { min_max(size_t(begin - stored_first), size_t(end - stored_first), lo, hi); },
+              transform);
+        });
+    }
+
+    // Min/max of the scalar over a time range. The part of the range that is
+    // older than the raw samples comes from the downsampled history.
+    DecimatedValues getValuesInTimeRange(Scalar* scalar, double start_time, double end_time, int32_t n_points, double scale = 1, double offset = 0) {
+        if (m_time.empty()) {
+            return getValuesInRange(scalar, -1, -1, n_points, scale, offset);
+        }
+
+        double raw_start = m_time.at(rawBegin());
+        if (start_time >= raw_start || m_tiers.oldestTime() >= raw_start) {
+            return getCachedValuesInRange(scalar, getTimeIndices(start_time, end_time), n_points, scale, offset);
+        }
+
+        DecimationTransform transform{.y_scale = scale, .y_offset = offset};
+        double span = MAX(end_time - start_time, 1e-12);
+        int32_t old_points = int32_t(n_points * MIN(1.0, (raw_start - start_time) / span));
+        DecimatedValues values = m_tiers.getValuesInRange(m_slots_by_scalar.at(scalar),
+                                                           start_time,
+                                                           MIN(end_time, raw_start),
+                                                           old_points,
+                                                           transform);
+        // Drop buckets that overlap with the raw samples
+        while (!values.x.empty() && values.x.back() >= raw_start) {
+            values.x.pop_back();
+            values.y_min.pop_back();
+            values.y_max.pop_back();
+        }
+        if (end_time >= raw_start) {
+            DecimatedValues recent = getCachedValuesInRange(scalar, getTimeIndices(raw_start, end_time), n_points - old_points, scale, offset);
+            values.x.insert(values.x.end(), recent.x.begin(), recent.x.end());
+            values.y_min.insert(values.y_min.end(), recent.y_min.begin(), recent.y_min.end());
+            values.y_max.insert(values.y_max.end(), recent.y_max.begin(), recent.y_max.end());
+        }
+        return values;
     }
 
     DecimatedValues getValuesInRange(Scalar* scalar, std::pair<int32_t, int32_t> times, int32_t n_points, double scale = 1, double offset = 0) {
@@ -154,33 +366,79 @@ class ScrollingBuffer {
             return time;
         }
 
-        time.reserve(size_t(times.second - times.first + 1));
-        time.insert(time.end(), m_time.begin() + times.first, m_time.begin() + times.second + 1);
+        size_t count = size_t(times.second - times.first + 1);
+        time.reserve(count);
+        m_time.copy(absoluteIndex(size_t(times.first)), count, std::back_inserter(time));
         return time;
     }
 
     std::vector<double> getSamplesInRange(Scalar* scalar, std::pair<int32_t, int32_t> times, double scale = 1, double offset = 0) {
         std::vector<double> samples;
-        if (times.first < 0 || times.second < 0 || times.second < times.first || !m_scalar_buffers.contains(scalar)) {
+        auto it = m_slots_by_scalar.find(scalar);
+        if (times.first < 0 || times.second < 0 || times.second < times.first || it == m_slots_by_scalar.end()) {
             return samples;
         }
 
-        auto const& data = m_scalar_buffers.at(scalar);
-        samples.reserve(size_t(times.second - times.first + 1));
-        for (int32_t i = times.first; i <= times.second; ++i) {
-            samples.push_back(scale * data[i] + offset);
-        }
+        size_t count = size_t(times.second - times.first + 1);
+        uint64_t first = absoluteIndex(size_t(times.first));
+        SlotSamples slot_samples = slotSamples(it->second, first, count);
+        SampleView const& view = slot_samples.view;
+        samples.reserve(count);
+        std::visit(
+          [&](auto const& values) {
+              if constexpr (std::is_same_v<std::decay_t<decltype(values)>, RunSpan>) {
+                  // Each run fills its rows at once
+                  samples.resize(count, NAN);
+                  values.forEachRun(view.valid_begin, values.size(), [&](size_t begin, size_t end, double value) {
+                      uint64_t row_begin = std::max(first, slot_samples.first_row + begin * slot_samples.divider);
+                      uint64_t row_end = std::min(first + count, slot_samples.first_row + end * slot_samples.divider);
+                      if (row_begin < row_end) {
+                          std::fill(samples.begin() + ptrdiff_t(row_begin - first), samples.begin() + ptrdiff_t(row_end - first), scale * value + offset);
+                      }
+                  });
+                  return;
+              }
+              // Scalars with a divider hold their value until the next sample
+              // so that every row of the common time axis has a value.
+              for (uint64_t row = first; row < first + count; ++row) {
+                  size_t i = row >= slot_samples.first_row ? size_t((row - slot_samples.first_row) / slot_samples.divider) : values.size();
+                  bool valid = i >= view.valid_begin && i < values.size();
+                  samples.push_back(valid ? scale * static_cast<double>(values[i]) + offset : NAN);
+              }
+          },
+          view.values);
         return samples;
     }
 
     void startSampling(Scalar* scalar) {
-        if (m_scalar_buffers.contains(scalar)) {
+        if (m_slots_by_scalar.contains(scalar)) {
             return;
+        }
+        size_t slot_idx;
+        if (m_free_slots.empty()) {
+            slot_idx = m_slots.size();
+            m_slots.emplace_back();
+            m_tiers.resizeSlots(m_slots.size());
         } else {
-            // Initialize buffer with NAN so that the non-existing samples are not plotted
-            m_scalar_buffers[scalar] = std::vector<double>(2 * m_buffer_size, NAN);
-            m_scalar_buffers_temp[scalar] = {};
+            slot_idx = m_free_slots.back();
+            m_free_slots.pop_back();
+            m_tiers.resetSlot(slot_idx);
         }
+        Slot& slot = m_slots[slot_idx];
+        slot.scalar = scalar;
+        slot.type = storageType(scalar->src);
+        slot.divider = std::max(scalar->sample_divider, 1u);
+        slot.column = allocateColumn(slot.type, slot.divider);
+        slot.runs.reset();
+        slot.pyramid.reset(columnStride(slot.divider));
+        // Earlier rows were not sampled so that they are not plotted
+        slot.valid_from = m_time.end();
+        slot.changes = 0;
+        slot.window_begin = m_time.end();
+        m_slots_by_scalar[scalar] = slot_idx;
+        recordToHistoryFile(slot_idx);
+        // The sampling thread picks up the new column after the next drain
+        m_layout_changed = true;
     }
 
     void startSampling(Vector2D* vector) {
@@ -189,68 +447,807 @@ class ScrollingBuffer {
     }
 
     void copySamples(Scalar& from, Scalar& to) {
-        m_scalar_buffers[&to] = m_scalar_buffers[&from];
+        auto it = m_slots_by_scalar.find(&from);
+        if (it != m_slots_by_scalar.end()) {
+            size_t from_idx = it->second;
+            // Columns are copied whole so the kept samples must be in place
+            finishResize();
+            // Starting may grow the slots and slabs so both are resolved afterwards
+            startSampling(&to);
+            Slot const& from_slot = m_slots[from_idx];
+            Slot& to_slot = m_slots[m_slots_by_scalar.at(&to)];
+            forgetDecimation(&to);
+            if (from_slot.divider != to_slot.divider) {
+                // Samples are taken on different rows
+                return;
+            }
+            if (from_slot.runs) {
+                freeColumn(to_slot);
+                to_slot.runs = std::make_unique<RunColumn>(*from_slot.runs);
+            } else {
+                visitColumn(from_slot, [&](auto const* from_data) {
+                    visitColumn(to_slot, [&](auto* to_data) {
+                        using To = std::remove_pointer_t<decltype(to_data)>;
+                        for (size_t i = 0; i < columnStride(to_slot.divider); ++i) {
+                            to_data[i] = toStorage<To>(static_cast<double>(from_data[i]));
+                        }
+                    });
+                });
+                to_slot.pyramid = from_slot.pyramid;
+            }
+            to_slot.valid_from = from_slot.valid_from;
+            m_tiers.copySlot(from_idx, m_slots_by_scalar.at(&to));
+        }
     }
 
     void copySamples(Vector2D& from, Vector2D& to) {
-        m_scalar_buffers[to.x] = m_scalar_buffers[from.x];
-        m_scalar_buffers[to.y] = m_scalar_buffers[from.y];
+        copySamples(*from.x, *to.x);
+        copySamples(*from.y, *to.y);
     }
 
     void stopSampling(Scalar* scalar) {
-        if (m_scalar_buffers.contains(scalar)) {
-            m_scalar_buffers.erase(scalar);
-            m_scalar_buffers_temp.erase(scalar);
+        auto it = m_slots_by_scalar.find(scalar);
+        if (it != m_slots_by_scalar.end()) {
+            size_t slot_idx = it->second;
+            m_slots_by_scalar.erase(it);
+            forgetDecimation(scalar);
+            Slot& slot = m_slots[slot_idx];
+            freeColumn(slot);
+            slot.scalar = nullptr;
+            m_free_slots.push_back(slot_idx);
+            if (m_history_file) {
+                m_history_file->setColumn(slot_idx, "", 0);
+            }
+            // Rows already in the rings must not be written to the slot once
+            // it has been given to another scalar.
+            for (auto& channel : m_channels) {
+                std::replace(channel->slots.begin(), channel->slots.end(), slot_idx, NO_SLOT);
+            }
+            m_layout_changed = true;
         }
     }
 
     std::pair<int32_t, int32_t> getTimeIndices(double start_time, double end_time) {
-        double latest_sample_time = (m_idx == 0) ? m_time[m_buffer_size - 1] : m_time[m_idx - 1];
-        end_time = std::min(latest_sample_time, end_time);
-        int32_t start_idx = m_idx;
-        int32_t end_idx = m_idx - 1 + m_buffer_size;
-        if (!m_full_buffer_looped) {
-            // Nothing sampled yet
-            if (m_idx == 0) {
-                return {-1, -1};
+        // Nothing sampled yet
+        if (m_time.empty()) {
+            return {-1, -1};
+        }
+        end_time = std::min(m_time.back(), end_time);
+        uint64_t start = m_time.lastAtOrBefore(start_time);
+        uint64_t end = std::max(m_time.lastAtOrBefore(end_time), start);
+        return {int32_t(historyIndex(start)), int32_t(historyIndex(end))};
+    }
+
+    // Times of the first samples after the time was shifted within the range
+    std::vector<double> getDiscontinuities(double start_time, double end_time) const {
+        std::vector<double> times;
+        for (uint64_t idx : m_time.discontinuities()) {
+            if (idx < m_time.end()) {
+                double time = m_time.at(idx);
+                if (time >= start_time && time <= end_time) {
+                    times.push_back(time);
+                }
             }
-            start_idx = binarySearch(start_time, 0, m_idx - 1);
-            end_idx = binarySearch(end_time, start_idx, m_idx - 1);
-        } else {
-            start_idx = binarySearch(start_time, start_idx, end_idx);
-            end_idx = binarySearch(end_time, start_idx, end_idx);
         }
-        end_idx = std::max(end_idx, start_idx);
-        return {start_idx, end_idx};
+        return times;
     }
 
     bool isScalarSampled(Scalar* scalar) {
-        return m_scalar_buffers.contains(scalar);
+        return m_slots_by_scalar.contains(scalar);
+    }
+
+    // True if the samples of the scalar are stored only where they change
+    bool isStoredAsRuns(Scalar* scalar) const {
+        auto it = m_slots_by_scalar.find(scalar);
+        return it != m_slots_by_scalar.end() && m_slots[it->second].runs != nullptr;
+    }
+
+    // Records the drained rows also to the file. Scalars that are already
+    // sampled are recorded from the next row onwards. nullptr stops recording.
+    void setHistoryFile(std::unique_ptr<HistoryFile> file) {
+        m_history_file = std::move(file);
+        for (size_t slot = 0; slot < m_slots.size(); ++slot) {
+            if (m_slots[slot].scalar != nullptr) {
+                recordToHistoryFile(slot, m_time.end());
+            }
+        }
+    }
+
+    HistoryFile const* historyFile() const {
+        return m_history_file.get();
     }
 
   private:
-    int32_t binarySearch(double t, int32_t start, int32_t end) {
-        int32_t original_start = start;
-        int32_t mid = std::midpoint(start, end);
-        while (start <= end) {
-            mid = std::midpoint(start, end);
-            double val = m_time[mid];
-            if (val < t) {
-                start = mid + 1;
-            } else if (val > t) {
-                end = mid - 1;
+    // Row layout in the sample rings
+    static constexpr size_t ROW_TIME = 0;
+    static constexpr size_t ROW_TIME_SHIFT = 1;
+    static constexpr size_t ROW_FIRST_VALUE = 2;
+    // Rings are sized by memory so that thousands of sampled scalars do not
+    // reserve gigabytes just to cover a stalled frame.
+    static constexpr size_t MIN_RING_ROWS = 256;
+    static constexpr size_t DEFAULT_RING_ROWS = 1 << 16;
+    static constexpr size_t RING_MEMORY_BUDGET = 64 << 20;
+
+    static constexpr size_t NO_SLOT = SIZE_MAX;
+    // Samples moved per frame after a resize
+    static constexpr size_t RESIZE_STEP_VALUES = 1 << 20;
+    // Minimum number of samples over which the changes of a scalar are
+    // counted before its encoding is reconsidered
+    static constexpr size_t ENCODING_WINDOW = 4096;
+    static constexpr size_t RUN_BYTES = sizeof(uint64_t) + sizeof(double);
+
+    using StorageType = std::variant<std::type_identity<int8_t>,
+                                     std::type_identity<int16_t>,
+                                     std::type_identity<int32_t>,
+                                     std::type_identity<uint8_t>,
+                                     std::type_identity<uint16_t>,
+                                     std::type_identity<uint32_t>,
+                                     std::type_identity<float>,
+                                     std::type_identity<double>>;
+
+    // Columns of one storage type. Column c owns columnStride() values at c * columnStride().
+    template <typename T>
+    struct ColumnSlab {
+        std::vector<T> data;
+        std::vector<size_t> free_columns;
+        size_t column_count = 0;
+    };
+    using Slabs = std::tuple<ColumnSlab<int8_t>,
+                             ColumnSlab<int16_t>,
+                             ColumnSlab<int32_t>,
+                             ColumnSlab<uint8_t>,
+                             ColumnSlab<uint16_t>,
+                             ColumnSlab<uint32_t>,
+                             ColumnSlab<float>,
+                             ColumnSlab<double>>;
+
+    // Values of a slowly changing scalar stored only when they change. Run i
+    // starts at sample index starts[i] and lasts until the next run. Runs
+    // before front have scrolled out of the history.
+    struct RunColumn {
+        std::vector<uint64_t> starts;
+        std::vector<double> values;
+        size_t front = 0;
+
+        // Returns true if the value starts a new run
+        bool push(uint64_t k, double value) {
+            if (front < starts.size() && sameValue(values.back(), value)) {
+                return false;
+            }
+            starts.push_back(k);
+            values.push_back(value);
+            return true;
+        }
+
+        // Drops the runs that end at or before sample k
+        void popBefore(uint64_t k) {
+            while (front + 1 < starts.size() && starts[front + 1] <= k) {
+                ++front;
+            }
+            if (front > 64 && 2 * front > starts.size()) {
+                starts.erase(starts.begin(), starts.begin() + ptrdiff_t(front));
+                values.erase(values.begin(), values.begin() + ptrdiff_t(front));
+                front = 0;
+            }
+        }
+
+        RunSpan span(uint64_t first, size_t count) const {
+            return {.starts = std::span(starts).subspan(front), .values = std::span(values).subspan(front), .first = first, .count = count};
+        }
+
+        size_t size() const {
+            return starts.size() - front;
+        }
+    };
+
+    struct Slot {
+        Scalar* scalar = nullptr; // nullptr for free slots
+        StorageType type;
+        // Column in the slab. Unused if the values are stored as runs.
+        size_t column = 0;
+        std::unique_ptr<RunColumn> runs;
+        // Min/max of blocks of the column. Empty if stored as runs.
+        MinMaxPyramid pyramid;
+        // Sampled on rows that are multiples of the divider
+        uint32_t divider = 1;
+        // Drained row count when the first value of the scalar was sampled.
+        // Older values in the column are garbage and read as NAN.
+        uint64_t valid_from = 0;
+        // Value changes since row window_begin for choosing the encoding
+        size_t changes = 0;
+        uint64_t window_begin = 0;
+    };
+
+    template <typename T>
+    struct ColumnWrite {
+        size_t row_idx;
+        size_t slot;
+        T* column; // nullptr if stored as runs
+        RunColumn* runs;
+        MinMaxPyramid* pyramid;
+        uint32_t divider;
+        size_t stride;
+        double* file_column; // nullptr if not recorded to a file
+        size_t* changes;
+    };
+    using ColumnWrites = std::tuple<std::vector<ColumnWrite<int8_t>>,
+                                    std::vector<ColumnWrite<int16_t>>,
+                                    std::vector<ColumnWrite<int32_t>>,
+                                    std::vector<ColumnWrite<uint8_t>>,
+                                    std::vector<ColumnWrite<uint16_t>>,
+                                    std::vector<ColumnWrite<uint32_t>>,
+                                    std::vector<ColumnWrite<float>>,
+                                    std::vector<ColumnWrite<double>>>;
+
+    // Positions of a drained row in the history and in the history file
+    struct RowPosition {
+        uint64_t row;
+        size_t column_idx;
+        size_t file_idx;
+        size_t previous_file_idx;
+    };
+
+    // Sources read on rows that are multiples of the divider
+    struct RateSources {
+        std::vector<size_t> slots;
+        std::vector<ValueSource> sources;
+    };
+
+    struct RateGroup {
+        uint32_t divider;
+        SamplingPlan plan;
+        size_t offset; // Position of the first value of the group in a row
+    };
+
+    // Columns from before setBufferSize() whose rows [begin, end) have not
+    // been moved yet
+    struct Resize {
+        std::map<uint32_t, Slabs> slabs;
+        std::vector<MinMaxPyramid> pyramids;
+        int32_t buffer_size;
+        uint64_t begin;
+        uint64_t end;
+    };
+
+    struct SamplingChannel {
+        SamplingChannel(std::map<uint32_t, RateSources> const& rates, size_t width, size_t ring_rows)
+            : ring(ring_rows, ROW_FIRST_VALUE + width) {
+            slots.reserve(width);
+            addresses.reserve(width);
+            groups.reserve(rates.size());
+            for (auto const& [divider, rate] : rates) {
+                groups.push_back({divider, SamplingPlan(rate.sources), slots.size()});
+                RateGroup const& group = groups.back();
+                for (size_t source_idx : group.plan.order()) {
+                    slots.push_back(rate.slots[source_idx]);
+                    addresses.push_back(valueSourceAddress(rate.sources[source_idx]));
+                }
+            }
+        }
+
+        // History slot of each row value in plan order. Owned by the GUI thread.
+        std::vector<size_t> slots;
+        // Built from copies of the scalar sources so that the sampling thread
+        // never reads a scalar that the GUI thread is deleting. Not modified
+        // after construction.
+        std::vector<RateGroup> groups;
+        // Address of each pointer source in plan order, nullptr for callables
+        std::vector<void const*> addresses;
+        SampleRing ring;
+    };
+
+    void publishChannel() {
+        std::map<uint32_t, RateSources> rates;
+        size_t width = 0;
+        for (size_t slot = 0; slot < m_slots.size(); ++slot) {
+            if (m_slots[slot].scalar != nullptr) {
+                RateSources& rate = rates[m_slots[slot].divider];
+                rate.slots.push_back(slot);
+                rate.sources.push_back(m_slots[slot].scalar->src);
+                ++width;
+            }
+        }
+        size_t row_bytes = (ROW_FIRST_VALUE + width) * sizeof(double);
+        size_t ring_rows = std::clamp(RING_MEMORY_BUDGET / row_bytes, MIN_RING_ROWS, m_ring_rows);
+        m_channels.push_back(std::make_unique<SamplingChannel>(rates, width, ring_rows));
+        m_producer_channel.store(m_channels.back().get());
+        m_layout_changed = false;
+    }
+
+    // Sampling thread. Announces the channel it is about to write before using
+    // it so that the GUI thread does not release it in the meantime.
+    SamplingChannel* acquireChannel() {
+        SamplingChannel* channel = m_producer_channel.load();
+        while (true) {
+            m_channel_in_use.store(channel);
+            SamplingChannel* latest = m_producer_channel.load();
+            if (latest == channel) {
+                return channel;
+            }
+            channel = latest;
+        }
+    }
+
+    void drainChannel(SamplingChannel& channel) {
+        // Resolve the column of each row value once per drain instead of per row
+        ColumnWrites writes;
+        std::vector<bool> written(m_slots.size(), false);
+        for (size_t i = 0; i < channel.slots.size(); ++i) {
+            if (channel.slots[i] != NO_SLOT) {
+                Slot& slot = m_slots[channel.slots[i]];
+                std::visit(
+                  [&](auto type) {
+                      using T = typename decltype(type)::type;
+                      T* data = nullptr;
+                      if (!slot.runs) {
+                          data = std::get<ColumnSlab<T>>(m_slabs[slot.divider]).data.data() + slot.column * columnStride(slot.divider);
+                      }
+                      double* file_column = m_history_file ? m_history_file->columnData(channel.slots[i]) : nullptr;
+                      std::get<std::vector<ColumnWrite<T>>>(writes).push_back({ROW_FIRST_VALUE + i,
+                                                                               channel.slots[i],
+                                                                               data,
+                                                                               slot.runs.get(),
+                                                                               &slot.pyramid,
+                                                                               slot.divider,
+                                                                               columnStride(slot.divider),
+                                                                               file_column,
+                                                                               &slot.changes});
+                  },
+                  slot.type);
+                written[channel.slots[i]] = true;
+            }
+        }
+
+        // Rows are drained in the order they were committed so the drained row
+        // count is the same row index that the sampling thread used.
+        channel.ring.drain([&](std::span<double const> row) {
+            if (row[ROW_TIME_SHIFT] != 0) {
+                shiftHistoryTime(row[ROW_TIME_SHIFT]);
+            }
+            double time = row[ROW_TIME];
+            RowPosition position{.row = m_time.end(), .column_idx = size_t(m_time.end() % size_t(m_buffer_size)), .file_idx = 0, .previous_file_idx = 0};
+            m_time.push(time);
+            if (m_time.size() > size_t(m_buffer_size)) {
+                m_time.popFront();
+            }
+            if (m_history_file) {
+                size_t capacity = m_history_file->capacity();
+                position.file_idx = size_t(position.row % capacity);
+                position.previous_file_idx = size_t((position.row + capacity - 1) % capacity);
+            }
+            std::apply([&](auto const&... typed_writes) { (writeRow(typed_writes, row, position), ...); }, writes);
+            m_tiers.endRow(time);
+            if (m_history_file) {
+                m_history_file->commitRow(position.row, time);
+            }
+            m_latest_time = time;
+        });
+
+        // Scalars whose sampling started after the channel was published have
+        // no values in these rows.
+        for (size_t slot = 0; slot < m_slots.size(); ++slot) {
+            if (m_slots[slot].scalar != nullptr && !written[slot]) {
+                m_slots[slot].valid_from = m_time.end();
+                recordToHistoryFile(slot);
+            }
+        }
+    }
+
+    template <typename T>
+    void writeRow(std::vector<ColumnWrite<T>> const& writes, std::span<double const> row, RowPosition const& position) {
+        for (ColumnWrite<T> const& write : writes) {
+            if (write.divider != 1 && position.row % write.divider != 0) {
+                // Not sampled on this row. The file has a single time column so
+                // the previous value is repeated.
+                if (write.file_column != nullptr && position.row > 0) {
+                    write.file_column[position.file_idx] = write.file_column[position.previous_file_idx];
+                }
+                continue;
+            }
+            T value = toStorage<T>(row[write.row_idx]);
+            if (write.runs != nullptr) {
+                *write.changes += write.runs->push(position.row / write.divider, static_cast<double>(value));
             } else {
-                return mid;
+                uint64_t k = position.row / write.divider;
+                size_t column_idx = write.divider == 1 ? position.column_idx : size_t(k % write.stride);
+                size_t previous_idx = column_idx == 0 ? write.stride - 1 : column_idx - 1;
+                *write.changes += !sameValue(write.column[previous_idx], value);
+                write.column[column_idx] = value;
+                write.pyramid->add(k, static_cast<double>(value));
+            }
+            m_tiers.add(write.slot, static_cast<double>(value));
+            if (write.file_column != nullptr) {
+                write.file_column[position.file_idx] = static_cast<double>(value);
             }
         }
-        return std::max(original_start, end);
     }
 
-    int32_t m_idx = 0;
+    // Sources are stored in their native width. 64-bit integers and callables
+    // are kept as double because they are read as double anyway.
+    static StorageType storageType(ValueSource const& src) {
+        return std::visit(
+          [](auto const& src) -> StorageType {
+              using T = std::decay_t<decltype(src)>;
+              if constexpr (std::is_pointer_v<T>) {
+                  using Value = std::remove_pointer_t<T>;
+                  if constexpr (std::is_same_v<Value, int64_t> || std::is_same_v<Value, uint64_t>) {
+                      return std::type_identity<double>{};
+                  } else {
+                      return std::type_identity<Value>{};
+                  }
+              } else {
+                  return std::type_identity<double>{};
+              }
+          },
+          src);
+    }
+
+    template <typename T>
+    static T toStorage(double value) {
+        if constexpr (std::is_floating_point_v<T>) {
+            return static_cast<T>(value);
+        } else {
+            // Values fit the column unless the source type changed while sampled
+            if (std::isnan(value)) {
+                return 0;
+            }
+            return static_cast<T>(std::clamp(value, double(std::numeric_limits<T>::lowest()), double(std::numeric_limits<T>::max())));
+        }
+    }
+
+    size_t allocateColumn(StorageType type, uint32_t divider) {
+        return std::visit(
+          [&](auto type) {
+              auto& slab = std::get<ColumnSlab<typename decltype(type)::type>>(m_slabs[divider]);
+              if (!slab.free_columns.empty()) {
+                  size_t column = slab.free_columns.back();
+                  slab.free_columns.pop_back();
+                  return column;
+              }
+              slab.data.resize((slab.column_count + 1) * columnStride(divider));
+              return slab.column_count++;
+          },
+          type);
+    }
+
+    // Also reached from the getters of decimated values on several threads at
+    // once so the slabs are only looked up, never inserted
+    template <typename Fn>
+    void visitColumn(Slot const& slot, Fn&& fn) {
+        std::visit(
+          [&](auto type) {
+              auto& slab = std::get<ColumnSlab<typename decltype(type)::type>>(m_slabs.at(slot.divider));
+              fn(slab.data.data() + slot.column * columnStride(slot.divider));
+          },
+          slot.type);
+    }
+
+    // Samples [start_idx, start_idx + count) of a history ring
+    template <typename T>
+    RingSpan<T> historySpan(std::span<T const> ring, size_t start_idx, size_t count) const {
+        return RingSpan<T>::fromRing(ring, start_idx, std::min(count, ring.size()));
+    }
+
+    // Stored samples of a slot for rows [first, first + count). Sample i was
+    // taken on row first_row + i * divider.
+    struct SlotSamples {
+        SampleView view;
+        uint64_t first_row;
+        uint32_t divider;
+    };
+
+    SlotSamples slotSamples(size_t slot_idx, uint64_t first, size_t count) {
+        Slot const& slot = m_slots[slot_idx];
+        SlotSamples samples{.view = {}, .first_row = first, .divider = slot.divider};
+        uint64_t valid_from = std::max(slot.valid_from, rawBegin());
+        uint64_t k_first = first;
+        size_t sample_count = count;
+        if (slot.divider == 1) {
+            samples.view.valid_begin = size_t(valid_from > first ? valid_from - first : 0);
+        } else {
+            // Start from the sample at or before the first row so that the
+            // value is known over the whole range.
+            uint64_t k_valid = (valid_from + slot.divider - 1) / slot.divider;
+            k_first = std::max(first / slot.divider, k_valid);
+            uint64_t k_end = (first + count - 1) / slot.divider + 1;
+            sample_count = k_end > k_first ? size_t(k_end - k_first) : 0;
+            samples.first_row = k_first * slot.divider;
+        }
+        if (slot.runs) {
+            samples.view.values = slot.runs->span(k_first, sample_count);
+            return samples;
+        }
+        visitColumn(slot, [&](auto const* data) {
+            using T = std::remove_cv_t<std::remove_pointer_t<decltype(data)>>;
+            size_t stride = columnStride(slot.divider);
+            samples.view.values = historySpan(std::span<T const>(data, stride), size_t(k_first % stride), sample_count);
+        });
+        return samples;
+    }
+
+    static size_t sampleCount(SampleView const& view) {
+        return std::visit([](auto const& values) { return values.size(); }, view.values);
+    }
+
+    // Calls fn(min_max) where min_max(begin, end, min, max) widens min and max
+    // with samples [begin, end) of the slot samples. Dense columns are answered
+    // from the pyramid and only the ends of the range are read from the samples.
+    template <typename Fn>
+    static DecimatedValues withMinMax(Slot const& slot, SlotSamples const& samples, Fn&& fn) {
+        size_t valid_begin = samples.view.valid_begin;
+        uint64_t k_first = samples.first_row / samples.divider;
+        return std::visit(
+          [&](auto const& values) {
+              if constexpr (std::is_same_v<std::decay_t<decltype(values)>, RunSpan>) {
+                  // Runs are reduced whole
+                  return fn([&](size_t begin, size_t end, double& lo, double& hi) {
+                      values.forEachRun(std::min(std::max(begin, valid_begin), end), end, [&](size_t, size_t, double value) {
+                          lo = MIN(value, lo);
+                          hi = MAX(value, hi);
+                      });
+                  });
+              } else {
+                  return fn([&](size_t begin, size_t end, double& lo, double& hi) {
+                      begin = std::min(std::max(begin, valid_begin), end);
+                      if (slot.pyramid.empty()) {
+                          values.forEachSegment(begin, end, [&](auto segment) { minMaxOf(segment, lo, hi); });
+                          return;
+                      }
+                      auto raw = [&](uint64_t raw_begin, uint64_t raw_end) {
+                          values.forEachSegment(size_t(raw_begin - k_first), size_t(raw_end - k_first), [&](auto segment) {
+                              minMaxOf(segment, lo, hi);
+                          });
+                      };
+                      slot.pyramid.minMax(k_first + begin, k_first + end, raw, lo, hi);
+                  });
+              }
+          },
+          samples.view.values);
+    }
+
+    template <typename Fn>
+    static void forEachSlab(Slabs& slabs, Slabs const& other, Fn&& fn) {
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            (fn(std::get<I>(slabs), std::get<I>(other)), ...);
+        }(std::make_index_sequence<std::tuple_size_v<Slabs>>{});
+    }
+
+    // Oldest row whose samples are readable. Rows that are still waiting to
+    // be moved after a resize read as NAN and are plotted from the tiers.
+    uint64_t rawBegin() const {
+        return m_resize ? std::max(m_resize->end, m_time.begin()) : m_time.begin();
+    }
+
+    // Moves the newest rows that are still in the old columns, at most
+    // RESIZE_STEP_VALUES samples per call. Rows dropped from the history in
+    // the meantime are skipped.
+    void continueResize(size_t max_values = RESIZE_STEP_VALUES) {
+        if (!m_resize) {
+            return;
+        }
+        Resize& resize = *m_resize;
+        resize.begin = std::max(resize.begin, m_time.begin());
+        size_t rows = std::max<size_t>(max_values / std::max<size_t>(m_slots_by_scalar.size(), 1), 1);
+        uint64_t first = resize.end - std::min<uint64_t>(rows, resize.end - std::min(resize.begin, resize.end));
+        for (size_t slot_idx = 0; slot_idx < m_slots.size(); ++slot_idx) {
+            Slot& slot = m_slots[slot_idx];
+            auto old_slabs = resize.slabs.find(slot.divider);
+            if (slot.scalar == nullptr || slot.runs || old_slabs == resize.slabs.end()) {
+                continue;
+            }
+            std::visit(
+              [&](auto type) {
+                  using T = typename decltype(type)::type;
+                  ColumnSlab<T> const& old_slab = std::get<ColumnSlab<T>>(old_slabs->second);
+                  if (slot.column >= old_slab.column_count) {
+                      // Allocated after the resize so there is nothing to move
+                      return;
+                  }
+                  size_t old_stride = columnStride(slot.divider, resize.buffer_size);
+                  size_t new_stride = columnStride(slot.divider);
+                  T const* from = old_slab.data.data() + slot.column * old_stride;
+                  T* to = std::get<ColumnSlab<T>>(m_slabs[slot.divider]).data.data() + slot.column * new_stride;
+                  uint64_t k_first = (first + slot.divider - 1) / slot.divider;
+                  uint64_t k_end = (resize.end + slot.divider - 1) / slot.divider;
+                  for (uint64_t k = k_first; k < k_end; ++k) {
+                      to[size_t(k % new_stride)] = from[size_t(k % old_stride)];
+                  }
+                  if (slot_idx < resize.pyramids.size()) {
+                      slot.pyramid.moveBlocks(resize.pyramids[slot_idx], k_first, k_end);
+                  }
+              },
+              slot.type);
+        }
+        resize.end = first;
+        if (resize.end <= resize.begin) {
+            m_resize.reset();
+        }
+    }
+
+    void finishResize() {
+        continueResize(SIZE_MAX);
+    }
+
+    template <typename T>
+    static bool sameValue(T a, T b) {
+        if constexpr (std::is_floating_point_v<T>) {
+            return a == b || (std::isnan(a) && std::isnan(b));
+        } else {
+            return a == b;
+        }
+    }
+
+    static size_t storageSize(StorageType type) {
+        return std::visit([](auto type) { return sizeof(typename decltype(type)::type); }, type);
+    }
+
+    void freeColumn(Slot& slot) {
+        slot.pyramid.clear();
+        if (slot.runs) {
+            slot.runs.reset();
+            return;
+        }
+        std::visit([&](auto type) { std::get<ColumnSlab<typename decltype(type)::type>>(m_slabs[slot.divider]).free_columns.push_back(slot.column); },
+                   slot.type);
+    }
+
+    // Scalars that changed rarely during the last window are stored as runs
+    // and go back to a column once runs would take more memory. The window is
+    // at least an eighth of the history so that converting the stored samples
+    // stays a small part of the work per sample.
+    void updateEncodings() {
+        if (m_resize) {
+            // Columns are being moved
+            return;
+        }
+        for (Slot& slot : m_slots) {
+            if (slot.scalar == nullptr) {
+                continue;
+            }
+            if (slot.runs) {
+                slot.runs->popBefore((m_time.begin() + slot.divider - 1) / slot.divider);
+            }
+            uint64_t samples = (m_time.end() - slot.window_begin) / slot.divider;
+            if (samples < std::max(ENCODING_WINDOW, columnStride(slot.divider) / 8)) {
+                continue;
+            }
+            size_t dense_bytes = size_t(samples) * storageSize(slot.type);
+            size_t run_bytes = slot.changes * RUN_BYTES;
+            if (!slot.runs && 2 * run_bytes <= dense_bytes) {
+                encodeRuns(slot);
+            } else if (slot.runs && run_bytes > dense_bytes) {
+                decodeRuns(slot);
+            }
+            slot.changes = 0;
+            slot.window_begin = m_time.end();
+        }
+    }
+
+    // Stored sample indices of the slot
+    std::pair<uint64_t, uint64_t> storedSampleRange(Slot const& slot) const {
+        uint64_t begin = std::max(slot.valid_from, m_time.begin());
+        return {(begin + slot.divider - 1) / slot.divider, (m_time.end() + slot.divider - 1) / slot.divider};
+    }
+
+    void encodeRuns(Slot& slot) {
+        auto runs = std::make_unique<RunColumn>();
+        auto [first, last] = storedSampleRange(slot);
+        visitColumn(slot, [&](auto const* data) {
+            size_t stride = columnStride(slot.divider);
+            for (uint64_t k = first; k < last; ++k) {
+                runs->push(k, static_cast<double>(data[size_t(k % stride)]));
+            }
+        });
+        freeColumn(slot);
+        slot.runs = std::move(runs);
+    }
+
+    void decodeRuns(Slot& slot) {
+        std::unique_ptr<RunColumn> runs = std::move(slot.runs);
+        slot.column = allocateColumn(slot.type, slot.divider);
+        slot.pyramid.reset(columnStride(slot.divider));
+        auto [first, last] = storedSampleRange(slot);
+        visitColumn(slot, [&](auto* data) {
+            using T = std::remove_pointer_t<decltype(data)>;
+            size_t stride = columnStride(slot.divider);
+            runs->span(first, size_t(last - first)).forEachRun(0, size_t(last - first), [&](size_t begin, size_t end, double value) {
+                for (uint64_t k = first + begin; k < first + end; ++k) {
+                    data[size_t(k % stride)] = static_cast<T>(value);
+                    slot.pyramid.add(k, value);
+                }
+            });
+        });
+    }
+
+    // Conversions between history indices and absolute sample indices, i.e.
+    // the number of rows drained before the sample. The sample of row r is
+    // stored at r % m_buffer_size.
+    size_t historyIndex(uint64_t absolute_idx) const {
+        size_t oldest = size_t(m_time.begin() % size_t(m_buffer_size));
+        return oldest + size_t(absolute_idx - m_time.begin());
+    }
+
+    uint64_t absoluteIndex(size_t history_idx) const {
+        size_t oldest = size_t(m_time.begin() % size_t(m_buffer_size));
+        return m_time.begin() + (history_idx - oldest);
+    }
+
+    // Column length for a sample divider. A divided column has room for every
+    // sample taken within m_buffer_size rows.
+    size_t columnStride(uint32_t divider, int32_t buffer_size) const {
+        return divider == 1 ? size_t(buffer_size) : size_t(buffer_size) / divider + 1;
+    }
+
+    size_t columnStride(uint32_t divider) const {
+        return columnStride(divider, m_buffer_size);
+    }
+
+    // Names the column of the slot in the history file. Rows before valid_from
+    // or before the first sample of a divided scalar read as NAN.
+    void recordToHistoryFile(size_t slot_idx, uint64_t valid_from) {
+        if (m_history_file) {
+            Slot const& slot = m_slots[slot_idx];
+            uint64_t first_sample = (valid_from + slot.divider - 1) / slot.divider * slot.divider;
+            if (!m_history_file->setColumn(slot_idx, slot.scalar->name_and_group, first_sample) && !m_history_file->isMapped()) {
+                m_history_file_error = std::format("Recording to history file {} stopped because the file could not be grown",
+                                                   m_history_file->filename());
+                m_history_file = nullptr;
+            }
+        }
+    }
+
+    void recordToHistoryFile(size_t slot_idx) {
+        recordToHistoryFile(slot_idx, m_slots[slot_idx].valid_from);
+    }
+
+    void shiftHistoryTime(double time) {
+        m_time.shift(time);
+        m_tiers.shift(time);
+        m_latest_time += time;
+        // The x values of the buckets moved
+        m_decimation_caches.clear();
+    }
+
+    void forgetDecimation(Scalar* scalar) {
+        std::erase_if(m_decimation_caches, [&](auto const& entry) { return entry.first.first == scalar; });
+    }
+
     int32_t m_buffer_size;
-    std::vector<double> m_time;
-    std::unordered_map<Scalar*, std::vector<double>> m_scalar_buffers;
-    std::vector<double> m_time_temp;
-    std::unordered_map<Scalar*, std::vector<double>> m_scalar_buffers_temp;
-    bool m_full_buffer_looped = false;
+    TimeAxis m_time;
+    HistoryTiers m_tiers;
+    // Sampled scalars are given dense slots. The values are stored in one slab
+    // per native type and sample divider so that narrow sources and slowly
+    // sampled scalars take a fraction of the memory.
+    std::vector<Slot> m_slots;
+    std::vector<size_t> m_free_slots;
+    std::unordered_map<Scalar*, size_t> m_slots_by_scalar;
+    std::map<uint32_t, Slabs> m_slabs;
+    std::optional<Resize> m_resize;
+    double m_latest_time = 0;
+    // Buckets of live plots by scalar and bucket size
+    struct PlotBuckets {
+        DecimationCache cache;
+        uint64_t used = 0; // Drain count when last plotted
+        std::mutex mutex;
+        PlotBuckets(uint64_t bucket_size)
+            : cache(bucket_size) {}
+    };
+    std::map<std::pair<Scalar*, uint64_t>, PlotBuckets> m_decimation_caches;
+    std::mutex m_decimation_mutex;
+    uint64_t m_drain_count = 0;
+    std::unique_ptr<HistoryFile> m_history_file;
+    std::optional<std::string> m_history_file_error;
+
+    // GUI thread owns the channels. The sampling thread only sees the newest one.
+    std::vector<std::unique_ptr<SamplingChannel>> m_channels;
+    std::atomic<SamplingChannel*> m_producer_channel = nullptr;
+    std::atomic<SamplingChannel*> m_channel_in_use = nullptr;
+    bool m_layout_changed = false;
+    size_t m_ring_rows = DEFAULT_RING_ROWS;
+    std::atomic<size_t> m_dropped_samples = 0;
+    size_t m_dropped_samples_total = 0;
+    double m_pending_time_shift = 0; // Sampling thread only
+    uint64_t m_committed_rows = 0; // Sampling thread only
+    std::vector<double> m_batch_row; // Sampling thread only
+    std::vector<std::pair<size_t, double const*>> m_batch_overrides; // Sampling thread only
 };
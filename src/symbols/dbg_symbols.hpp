@@ -42,6 +42,10 @@ class DbgSymbols {
   public:
     static DbgSymbols const& getSymbols();
 
+    /// @brief Load the symbols of the current process and its loaded modules again.
+    /// getSymbols() should be used instead unless a separate copy is needed, e.g. for benchmarking loading.
+    DbgSymbols();
+
     /// @brief Load global symbols from JSON file
     /// @param symbol_json JSON file from which the global symbols are loaded if it matches the current binary.
     DbgSymbols(std::string const& symbol_json);
@@ -96,7 +100,6 @@ class DbgSymbols {
 #endif
 
   private:
-    DbgSymbols();
     bool loadSymbolsFromJson(std::string const& json);
     void sortSymbols();
     void initSymbolsFromPdb();
@@ -0,0 +1,250 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+// Timestamps of a sample history. Samples are addressed by their absolute
+// index, i.e. the number of samples pushed before them.
+//
+// Regularly spaced timestamps are stored as runs of t0 + n * dt so that a fixed
+// step sampling takes no memory per sample and finding a time is arithmetic.
+// Timestamps that do not fit a run are stored explicitly until three of them
+// are regularly spaced again.
+//
+// Timestamps are stored relative to a common offset so that shifting the
+// whole axis is a single addition. The index of the first sample after each
+// shift is kept as a discontinuity.
+class TimeAxis {
+  public:
+    void push(double time) {
+        time -= m_offset;
+        uint64_t idx = end();
+        if (!m_runs.empty()) {
+            Run& last = m_runs.back();
+            if (last.times.empty()) {
+                double predicted = last.timeAt(idx);
+                if (std::abs(time - predicted) <= STEP_TOLERANCE * last.dt) {
+                    ++last.count;
+                    ++m_size;
+                    return;
+                }
+            } else {
+                last.times.push_back(time);
+                ++last.count;
+                ++m_size;
+                compactTail();
+                return;
+            }
+        }
+        m_runs.push_back({.begin = idx, .count = 1, .origin = idx, .times = {time}});
+        ++m_size;
+    }
+
+    // Drops the oldest samples
+    void popFront(size_t count = 1) {
+        uint64_t old_end = end();
+        count = std::min(count, m_size);
+        m_size -= count;
+        while (count > 0) {
+            Run& first = m_runs.front();
+            size_t popped = std::min(count, first.count);
+            first.begin += popped;
+            first.count -= popped;
+            if (!first.times.empty()) {
+                first.times.erase(first.times.begin(), first.times.begin() + popped);
+            }
+            if (first.count == 0) {
+                m_runs.pop_front();
+            }
+            count -= popped;
+        }
+        if (m_runs.empty()) {
+            m_begin = old_end;
+        }
+        while (!m_discontinuities.empty() && m_discontinuities.front() <= begin()) {
+            m_discontinuities.pop_front();
+        }
+    }
+
+    void clear() {
+        m_begin = end();
+        m_runs.clear();
+        m_size = 0;
+        m_discontinuities.clear();
+    }
+
+    // Absolute index of the oldest sample
+    uint64_t begin() const {
+        return m_runs.empty() ? m_begin : m_runs.front().begin;
+    }
+
+    // Absolute index of the next pushed sample
+    uint64_t end() const {
+        return m_runs.empty() ? m_begin : m_runs.back().begin + m_runs.back().count;
+    }
+
+    size_t size() const {
+        return m_size;
+    }
+
+    bool empty() const {
+        return m_size == 0;
+    }
+
+    size_t runCount() const {
+        return m_runs.size();
+    }
+
+    double at(uint64_t idx) const {
+        return findRun(idx).timeAt(idx) + m_offset;
+    }
+
+    double back() const {
+        return m_runs.back().timeAt(end() - 1) + m_offset;
+    }
+
+    // Absolute index of the last sample at or before the time. The oldest
+    // sample is returned if all samples are after the time.
+    uint64_t lastAtOrBefore(double time) const {
+        time -= m_offset;
+        auto run = std::upper_bound(m_runs.begin(), m_runs.end(), time, [](double t, Run const& r) {
+            return t < r.timeAt(r.begin);
+        });
+        if (run == m_runs.begin()) {
+            return begin();
+        }
+        --run;
+        uint64_t last = run->begin + run->count - 1;
+        if (!run->times.empty()) {
+            auto it = std::upper_bound(run->times.begin(), run->times.end(), time);
+            return run->begin + uint64_t(it - run->times.begin()) - 1;
+        }
+        double steps = std::floor((time - run->t0) / run->dt);
+        uint64_t idx = std::clamp<uint64_t>(run->origin + uint64_t(std::max(steps, 0.0)), run->begin, last);
+        // Rounding may put the estimate one step off
+        while (idx < last && run->timeAt(idx + 1) <= time) {
+            ++idx;
+        }
+        while (idx > run->begin && run->timeAt(idx) > time) {
+            --idx;
+        }
+        return idx;
+    }
+
+    // Adds offset to every timestamp
+    void shift(double offset) {
+        m_offset += offset;
+        if (!empty() && (m_discontinuities.empty() || m_discontinuities.back() != end())) {
+            m_discontinuities.push_back(end());
+        }
+    }
+
+    // Absolute indices of the first samples after shift() from the oldest to
+    // the newest. The newest may not have been pushed yet.
+    std::deque<uint64_t> const& discontinuities() const {
+        return m_discontinuities;
+    }
+
+    // Copies the timestamps of samples [first, first + count)
+    template <typename OutputIt>
+    OutputIt copy(uint64_t first, size_t count, OutputIt out) const {
+        uint64_t stop = first + count;
+        auto run = std::upper_bound(m_runs.begin(), m_runs.end(), first, [](uint64_t idx, Run const& r) {
+            return idx < r.begin;
+        });
+        if (run != m_runs.begin()) {
+            --run;
+        }
+        for (; run != m_runs.end() && first < stop; ++run) {
+            uint64_t run_end = std::min(run->begin + run->count, stop);
+            for (; first < run_end; ++first) {
+                *out++ = run->timeAt(first) + m_offset;
+            }
+        }
+        return out;
+    }
+
+  private:
+    // Relative error of the predicted timestamp that is still considered
+    // regular. Timestamps accumulated with += drift slowly from t0 + n * dt.
+    static constexpr double STEP_TOLERANCE = 1e-6;
+
+    struct Run {
+        uint64_t begin;
+        size_t count;
+        // Regular run: time of sample i is t0 + (i - origin) * dt
+        uint64_t origin = 0;
+        double t0 = 0;
+        double dt = 0;
+        // Irregular run: time of sample i is times[i - begin]
+        std::deque<double> times;
+
+        double timeAt(uint64_t idx) const {
+            if (!times.empty()) {
+                return times[idx - begin];
+            }
+            return t0 + double(idx - origin) * dt;
+        }
+    };
+
+    Run const& findRun(uint64_t idx) const {
+        auto run = std::upper_bound(m_runs.begin(), m_runs.end(), idx, [](uint64_t i, Run const& r) {
+            return i < r.begin;
+        });
+        return *std::prev(run);
+    }
+
+    // Moves the last three explicit timestamps into a regular run if they are
+    // evenly spaced.
+    void compactTail() {
+        Run& last = m_runs.back();
+        size_t n = last.times.size();
+        if (n < 3) {
+            return;
+        }
+        double t1 = last.times[n - 3];
+        double t2 = last.times[n - 2];
+        double t3 = last.times[n - 1];
+        double dt = 0.5 * (t3 - t1);
+        if (!(dt > 0) || std::abs((t3 - t2) - (t2 - t1)) > STEP_TOLERANCE * dt) {
+            return;
+        }
+        uint64_t origin = last.begin + last.count - 3;
+        last.times.resize(n - 3);
+        last.count -= 3;
+        if (last.count == 0) {
+            m_runs.pop_back();
+        }
+        m_runs.push_back({.begin = origin, .count = 3, .origin = origin, .t0 = t1, .dt = dt, .times = {}});
+    }
+
+    std::deque<Run> m_runs;
+    uint64_t m_begin = 0; // Used when there are no runs
+    size_t m_size = 0;
+    double m_offset = 0;
+    std::deque<uint64_t> m_discontinuities;
+};
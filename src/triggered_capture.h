@@ -0,0 +1,319 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include "DbgGui/dbg_gui.h"
+#include "sampling_plan.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+enum class TriggerEdge {
+    Rising,
+    Falling,
+    Either,
+};
+
+struct CaptureSettings {
+    size_t pre_samples = 1000;
+    size_t post_samples = 1000;
+    TriggerEdge edge = TriggerEdge::Rising;
+    double level = 0;
+    // Arm again after a capture has been completed
+    bool rearm = true;
+};
+
+struct CaptureSignal {
+    std::string name;
+    ValueSource src;
+    double scale = 1;
+    double offset = 0;
+};
+
+// Samples of the captured signals around one trigger. Values are scaled.
+struct Capture {
+    uint64_t trigger_id;
+    std::string trigger_name;
+    double trigger_time;
+    std::vector<std::string> names;
+    std::vector<double> time;
+    std::vector<std::vector<double>> values;
+};
+
+// Oscilloscope style capture of signals around a level crossing of the first
+// signal. Every sample is copied into a pre-trigger ring so that the samples
+// before the trigger are available without keeping the whole history. When
+// the trigger fires, the ring is frozen into a capture and the post-trigger
+// samples are appended to it.
+class CaptureTrigger {
+  public:
+    CaptureTrigger(uint64_t id, std::vector<CaptureSignal> signals, CaptureSettings const& settings)
+        : m_id(id),
+          m_settings(settings) {
+        std::vector<ValueSource> sources;
+        for (CaptureSignal const& signal : signals) {
+            sources.push_back(signal.src);
+        }
+        m_plan = SamplingPlan(sources);
+        // Signals are kept in plan order so that gathered rows need no reordering
+        for (size_t source_idx : m_plan.order()) {
+            if (source_idx == 0) {
+                m_trigger_pos = m_signals.size();
+            }
+            m_signals.push_back(signals[source_idx]);
+            m_addresses.push_back(valueSourceAddress(signals[source_idx].src));
+        }
+        m_name = signals.front().name;
+        m_row.resize(rowWidth());
+        m_live.resize(m_signals.size());
+        m_pre_ring.resize(m_settings.pre_samples * rowWidth());
+        resetSnapshot();
+    }
+
+    // Sampling thread. Reads the signals and evaluates the trigger.
+    void sample(double time) {
+        m_plan.gather(m_row.data() + 1);
+        processRow(time);
+    }
+
+    // Sampling thread. Signals listed in blocks take their values from the
+    // block and the other signals are read once.
+    void sampleBatch(std::span<double const> times, std::span<DbgGui_SampleBlock const> blocks) {
+        m_plan.gather(m_live.data());
+        for (size_t t = 0; t < times.size(); ++t) {
+            std::copy(m_live.begin(), m_live.end(), m_row.begin() + 1);
+            for (DbgGui_SampleBlock const& block : blocks) {
+                for (size_t i = 0; i < m_addresses.size(); ++i) {
+                    if (m_addresses[i] == block.src) {
+                        m_row[1 + i] = block.values[t];
+                    }
+                }
+            }
+            processRow(times[t]);
+        }
+    }
+
+    // Completed captures since the previous call
+    std::vector<Capture> takeCaptures() {
+        return std::exchange(m_completed, {});
+    }
+
+    uint64_t id() const {
+        return m_id;
+    }
+
+    std::string const& name() const {
+        return m_name;
+    }
+
+    CaptureSettings const& settings() const {
+        return m_settings;
+    }
+
+    // False once a capture has been completed without rearm
+    bool armed() const {
+        return m_state != State::Done;
+    }
+
+    size_t captureCount() const {
+        return m_capture_count;
+    }
+
+  private:
+    enum class State {
+        Armed,
+        PostTrigger,
+        Done,
+    };
+
+    // Row layout is time followed by the raw signal values
+    size_t rowWidth() const {
+        return 1 + m_signals.size();
+    }
+
+    double scaledTriggerValue() const {
+        CaptureSignal const& trigger = m_signals[m_trigger_pos];
+        return m_row[1 + m_trigger_pos] * trigger.scale + trigger.offset;
+    }
+
+    bool triggered(double value) const {
+        if (!m_has_previous) {
+            return false;
+        }
+        double level = m_settings.level;
+        bool rising = m_previous_value < level && value >= level;
+        bool falling = m_previous_value > level && value <= level;
+        switch (m_settings.edge) {
+            case TriggerEdge::Rising:
+                return rising;
+            case TriggerEdge::Falling:
+                return falling;
+            case TriggerEdge::Either:
+                return rising || falling;
+        }
+        return false;
+    }
+
+    void processRow(double time) {
+        m_row[0] = time;
+        double value = scaledTriggerValue();
+        if (m_state == State::Armed && triggered(value)) {
+            // Freeze the pre-trigger samples from the oldest to the newest
+            size_t width = rowWidth();
+            for (size_t i = 0; i < m_pre_count; ++i) {
+                size_t row = (m_pre_next + m_settings.pre_samples - m_pre_count + i) % m_settings.pre_samples;
+                m_snapshot.insert(m_snapshot.end(), m_pre_ring.begin() + row * width, m_pre_ring.begin() + (row + 1) * width);
+            }
+            m_trigger_time = time;
+            m_post_remaining = m_settings.post_samples + 1; // Trigger sample and post-trigger samples
+            m_state = State::PostTrigger;
+        }
+        if (m_state == State::PostTrigger) {
+            m_snapshot.insert(m_snapshot.end(), m_row.begin(), m_row.end());
+            if (--m_post_remaining == 0) {
+                completeCapture();
+            }
+        }
+
+        if (m_settings.pre_samples > 0) {
+            std::copy(m_row.begin(), m_row.end(), m_pre_ring.begin() + m_pre_next * rowWidth());
+            m_pre_next = (m_pre_next + 1) % m_settings.pre_samples;
+            m_pre_count = std::min(m_pre_count + 1, m_settings.pre_samples);
+        }
+        m_previous_value = value;
+        m_has_previous = true;
+    }
+
+    void completeCapture() {
+        size_t width = rowWidth();
+        size_t row_count = m_snapshot.size() / width;
+        Capture capture{
+          .trigger_id = m_id,
+          .trigger_name = m_name,
+          .trigger_time = m_trigger_time,
+          .names = std::vector<std::string>(m_signals.size()),
+          .time = std::vector<double>(row_count),
+          .values = std::vector<std::vector<double>>(m_signals.size(), std::vector<double>(row_count)),
+        };
+        // Signals are returned in the order they were given
+        std::vector<size_t> const& order = m_plan.order();
+        for (size_t i = 0; i < m_signals.size(); ++i) {
+            capture.names[order[i]] = m_signals[i].name;
+        }
+        for (size_t row = 0; row < row_count; ++row) {
+            double const* values = m_snapshot.data() + row * width;
+            capture.time[row] = values[0];
+            for (size_t i = 0; i < m_signals.size(); ++i) {
+                capture.values[order[i]][row] = values[1 + i] * m_signals[i].scale + m_signals[i].offset;
+            }
+        }
+        m_completed.push_back(std::move(capture));
+        ++m_capture_count;
+        m_state = m_settings.rearm ? State::Armed : State::Done;
+        resetSnapshot();
+    }
+
+    void resetSnapshot() {
+        m_snapshot.clear();
+        m_snapshot.reserve((m_settings.pre_samples + 1 + m_settings.post_samples) * rowWidth());
+    }
+
+    uint64_t m_id;
+    std::string m_name;
+    CaptureSettings m_settings;
+    std::vector<CaptureSignal> m_signals;
+    std::vector<void const*> m_addresses;
+    SamplingPlan m_plan;
+    size_t m_trigger_pos = 0;
+
+    State m_state = State::Armed;
+    std::vector<double> m_row;
+    std::vector<double> m_live; // Values read once per batch
+    std::vector<double> m_pre_ring;
+    size_t m_pre_next = 0;
+    size_t m_pre_count = 0;
+    std::vector<double> m_snapshot;
+    size_t m_post_remaining = 0;
+    double m_trigger_time = 0;
+    double m_previous_value = 0;
+    bool m_has_previous = false;
+    size_t m_capture_count = 0;
+    std::vector<Capture> m_completed;
+};
+
+// Armed capture triggers. The owner serializes calls from the sampling thread
+// and the GUI thread; DbgGui holds the sampling mutex like for pause triggers.
+class CaptureEngine {
+  public:
+    uint64_t arm(std::vector<CaptureSignal> signals, CaptureSettings const& settings) {
+        uint64_t id = m_next_id++;
+        m_triggers.emplace_back(id, std::move(signals), settings);
+        return id;
+    }
+
+    void disarm(uint64_t id) {
+        std::erase_if(m_triggers, [&](CaptureTrigger const& trigger) { return trigger.id() == id; });
+    }
+
+    void sample(double time) {
+        for (CaptureTrigger& trigger : m_triggers) {
+            if (trigger.armed()) {
+                trigger.sample(time);
+            }
+        }
+    }
+
+    void sampleBatch(std::span<double const> times, std::span<DbgGui_SampleBlock const> blocks) {
+        for (CaptureTrigger& trigger : m_triggers) {
+            if (trigger.armed()) {
+                trigger.sampleBatch(times, blocks);
+            }
+        }
+    }
+
+    std::vector<Capture> takeCaptures() {
+        std::vector<Capture> captures;
+        for (CaptureTrigger& trigger : m_triggers) {
+            for (Capture& capture : trigger.takeCaptures()) {
+                captures.push_back(std::move(capture));
+            }
+        }
+        return captures;
+    }
+
+    std::vector<CaptureTrigger> const& triggers() const {
+        return m_triggers;
+    }
+
+    bool empty() const {
+        return m_triggers.empty();
+    }
+
+  private:
+    std::vector<CaptureTrigger> m_triggers;
+    uint64_t m_next_id = 1;
+};
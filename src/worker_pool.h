@@ -0,0 +1,148 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+// Threads that run the iterations of a loop in parallel, e.g. the decimation
+// of all plots of a frame. The thread waiting for the loop takes part in it so
+// a pool without threads runs it serially. The threads sleep between loops.
+class WorkerPool {
+  public:
+    // One thread less than the cores because the waiting thread also works
+    static size_t defaultThreadCount() {
+        return std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    }
+
+    explicit WorkerPool(size_t thread_count = defaultThreadCount()) {
+        for (size_t i = 0; i < thread_count; ++i) {
+            m_threads.emplace_back([this](std::stop_token stop) { run(stop); });
+        }
+    }
+
+    WorkerPool(WorkerPool const&) = delete;
+    WorkerPool& operator=(WorkerPool const&) = delete;
+
+    size_t threadCount() const {
+        return m_threads.size();
+    }
+
+    // Calls fn(i) for i in [0, count) and returns after all the calls have
+    // returned. Not reentrant.
+    void parallelFor(size_t count, std::function<void(size_t)> fn) {
+        if (m_threads.empty() || count <= 1) {
+            for (size_t i = 0; i < count; ++i) {
+                fn(i);
+            }
+            return;
+        }
+        start(count, std::move(fn));
+        wait();
+    }
+
+    // Starts calling fn(i) for i in [0, count) on the threads and returns
+    // right away. The loop must be finished with wait() from the same thread
+    // before the next one is started.
+    void start(size_t count, std::function<void(size_t)> fn) {
+        {
+            std::scoped_lock lock(m_mutex);
+            m_fn = std::move(fn);
+            m_count = count;
+            m_next = 0;
+            m_done = 0;
+            ++m_generation;
+        }
+        m_work_cv.notify_all();
+    }
+
+    // Takes part in the loop of start() and returns after all the calls have
+    // returned. Returns right away if no loop was started.
+    void wait() {
+        std::unique_lock lock(m_mutex);
+        if (!m_fn) {
+            return;
+        }
+        lock.unlock();
+        // Only wait() changes the loop once it has been started
+        size_t done = work(m_fn, m_count);
+        lock.lock();
+        m_done += done;
+        // Threads that are still inside the loop hold on to fn
+        m_done_cv.wait(lock, [&] { return m_done == m_count && m_active == 0; });
+        m_fn = nullptr;
+    }
+
+  private:
+    void run(std::stop_token stop) {
+        uint64_t generation = 0;
+        std::unique_lock lock(m_mutex);
+        while (m_work_cv.wait(lock, stop, [&] { return m_generation != generation; })) {
+            generation = m_generation;
+            // The loop may have been finished by the others already
+            if (!m_fn) {
+                continue;
+            }
+            std::function<void(size_t)> const& fn = m_fn;
+            size_t count = m_count;
+            ++m_active;
+            lock.unlock();
+            size_t done = work(fn, count);
+            lock.lock();
+            m_done += done;
+            --m_active;
+            if (m_done == m_count && m_active == 0) {
+                m_done_cv.notify_all();
+            }
+        }
+    }
+
+    // Takes iterations until there are none left. Returns the number taken.
+    size_t work(std::function<void(size_t)> const& fn, size_t count) {
+        size_t done = 0;
+        for (size_t i = m_next.fetch_add(1); i < count; i = m_next.fetch_add(1)) {
+            fn(i);
+            ++done;
+        }
+        return done;
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable_any m_work_cv;
+    std::condition_variable m_done_cv;
+    std::function<void(size_t)> m_fn;
+    size_t m_count = 0;
+    std::atomic<size_t> m_next = 0;
+    size_t m_done = 0;
+    size_t m_active = 0;
+    uint64_t m_generation = 0;
+    // Last so that the threads are stopped before the state they use is destroyed
+    std::vector<std::jthread> m_threads;
+};
@@ -0,0 +1,88 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "background_sampler.h"
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Background sampler calls at a fixed rate with advancing sample time") {
+    std::mutex mutex;
+    std::vector<double> times;
+    BackgroundSampler sampler(1e-3, [&](double time) {
+        std::scoped_lock lock(mutex);
+        times.push_back(time);
+    });
+    sampler.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    sampler.stop();
+
+    // Loose bounds because the test machine may be loaded
+    REQUIRE(times.size() > 20);
+    REQUIRE(times.size() < 150);
+    REQUIRE(times[0] == 0);
+    for (size_t i = 1; i < times.size(); ++i) {
+        REQUIRE(times[i] > times[i - 1]);
+    }
+}
+
+TEST_CASE("Background sampler skips and reports missed deadlines") {
+    std::vector<double> times;
+    BackgroundSampler sampler(1e-3, [&](double time) {
+        times.push_back(time);
+        if (times.size() == 2) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+    });
+    sampler.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    sampler.stop();
+
+    uint64_t missed = sampler.takeMissedDeadlineCount();
+    REQUIRE(missed >= 15);
+    REQUIRE(sampler.takeMissedDeadlineCount() == 0);
+    // Sample time jumps over the skipped deadlines
+    REQUIRE(times[2] - times[1] >= 15e-3);
+}
+
+TEST_CASE("Background sampler restarts its schedule without missing deadlines") {
+    std::vector<double> times;
+    BackgroundSampler* sampler_ptr = nullptr;
+    BackgroundSampler sampler(1e-3, [&](double time) {
+        times.push_back(time);
+        if (times.size() == 2) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            sampler_ptr->restartSchedule();
+        }
+    });
+    sampler_ptr = &sampler;
+    sampler.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    sampler.stop();
+
+    // Sample time continues from the previous sample
+    REQUIRE(times[2] - times[1] < 15e-3);
+}
@@ -57,6 +57,19 @@ TEST_CASE("CSV signal names can be made unique") {
     CHECK(makeUniqueCsvSignalNames(names) == std::vector<std::string>{"time", "sig#0", "sig#1", "other", "sig#2"});
 }
 
+TEST_CASE("CSV parser detects the delimiter and skips lines before the header") {
+    std::string csv = "Title line\ntime;sig\n0;1.5\n1;x\n2;3\n";
+
+    auto columns = parseCsvColumns(csv);
+
+    REQUIRE(columns.has_value());
+    CHECK(columns->names == std::vector<std::string>{"time", "sig"});
+    CHECK(columns->columns[0] == std::vector<double>{0, 1, 2});
+    CHECK(columns->columns[1][0] == 1.5);
+    CHECK(std::isnan(columns->columns[1][1]));
+    CHECK(!parseCsvColumns("a,b\n").has_value());
+}
+
 TEST_CASE("Decimation clamps requested point count when decimating") {
     std::vector<double> x(MIN_PLOT_SAMPLE_COUNT + 2);
     std::iota(x.begin(), x.end(), 0.0);
@@ -149,3 +162,30 @@ TEST_CASE("Decimation ignores NaNs unless the whole bucket is NaN") {
     CHECK(std::isnan(values.y_min[1]));
     CHECK(std::isnan(values.y_max[1]));
 }
+
+TEST_CASE("Decimation of a wrapped ring matches decimation of the unwrapped samples") {
+    std::vector<double> x(MIN_PLOT_SAMPLE_COUNT * 3);
+    std::iota(x.begin(), x.end(), 0.0);
+    std::vector<double> y(x.size());
+    for (size_t i = 0; i < y.size(); ++i) {
+        y[i] = double((i * 7919) % 101);
+    }
+
+    // Same samples stored in a ring whose oldest sample is at index 100
+    size_t start = 100;
+    std::vector<double> x_ring(x.size());
+    std::vector<double> y_ring(y.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+        x_ring[(start + i) % x.size()] = x[i];
+        y_ring[(start + i) % y.size()] = y[i];
+    }
+    auto x_span = RingSpan<double>::fromRing(x_ring, start, x.size());
+    auto y_span = RingSpan<double>::fromRing(y_ring, start, y.size());
+    REQUIRE(x_span.tail.size() == start);
+
+    DecimatedValues expected = decimateValues(x, y, MIN_PLOT_SAMPLE_COUNT);
+    DecimatedValues values = decimateValues([&](size_t i) { return x_span[i]; }, SampleView{.values = y_span}, MIN_PLOT_SAMPLE_COUNT);
+    CHECK(values.x == expected.x);
+    CHECK(values.y_min == expected.y_min);
+    CHECK(values.y_max == expected.y_max);
+}
@@ -0,0 +1,150 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include <catch2/catch_test_macros.hpp>
+
+#include "minmax_kernel.h"
+#include "plot_decimation.h"
+
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr MinMaxKernel KERNELS[] = {MinMaxKernel::Scalar, MinMaxKernel::Sse2, MinMaxKernel::Avx2};
+
+// Restores the startup kernel when the test ends
+struct KernelGuard {
+    MinMaxKernel kernel = minMaxKernel();
+    ~KernelGuard() {
+        setMinMaxKernel(kernel);
+    }
+};
+
+template <typename T>
+std::vector<T> awkwardValues(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+    std::vector<T> values(count);
+    for (T& value : values) {
+        switch (rng() % 16) {
+            case 0:
+                value = std::numeric_limits<T>::quiet_NaN();
+                break;
+            case 1:
+                value = T(-0.0);
+                break;
+            case 2:
+                value = T(0.0);
+                break;
+            case 3:
+                value = rng() % 2 ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
+                break;
+            default:
+                value = T(dist(rng));
+        }
+    }
+    return values;
+}
+
+template <typename T>
+void checkKernelsAgree(std::vector<T> const& values) {
+    KernelGuard guard;
+    // Every length and start offset around the vector widths
+    for (size_t begin = 0; begin < 17; ++begin) {
+        for (size_t count = 0; begin + count <= values.size() && count < 70; ++count) {
+            std::span<T const> span(values.data() + begin, count);
+            setMinMaxKernel(MinMaxKernel::Scalar);
+            double expected_min = std::numeric_limits<double>::infinity();
+            double expected_max = -std::numeric_limits<double>::infinity();
+            minMaxOf(span, expected_min, expected_max);
+            for (MinMaxKernel kernel : KERNELS) {
+                if (!setMinMaxKernel(kernel)) {
+                    continue;
+                }
+                double min = std::numeric_limits<double>::infinity();
+                double max = -std::numeric_limits<double>::infinity();
+                minMaxOf(span, min, max);
+                REQUIRE(std::bit_cast<uint64_t>(min) == std::bit_cast<uint64_t>(expected_min));
+                REQUIRE(std::bit_cast<uint64_t>(max) == std::bit_cast<uint64_t>(expected_max));
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("Min/max kernels skip NAN and agree on the sign of zero") {
+    std::vector<double> values = {NAN, -0.0, 3, NAN, 0.0, -2, NAN};
+    KernelGuard guard;
+    for (MinMaxKernel kernel : KERNELS) {
+        if (!setMinMaxKernel(kernel)) {
+            continue;
+        }
+        double min = INFINITY;
+        double max = -INFINITY;
+        minMaxOf(std::span<double const>(values).first(2), min, max);
+        CHECK(min == 0);
+        CHECK_FALSE(std::signbit(min));
+        minMaxOf(std::span<double const>(values), min, max);
+        CHECK(min == -2);
+        CHECK(max == 3);
+
+        // Only NAN leaves the range untouched
+        double nan_min = INFINITY;
+        double nan_max = -INFINITY;
+        minMaxOf(std::span<double const>(values).subspan(6), nan_min, nan_max);
+        CHECK(nan_min == INFINITY);
+        CHECK(nan_max == -INFINITY);
+    }
+}
+
+TEST_CASE("Min/max kernels are bit-identical to the scalar kernel") {
+    checkKernelsAgree(awkwardValues<double>(100, 1));
+    checkKernelsAgree(awkwardValues<float>(100, 2));
+}
+
+TEST_CASE("Decimation output is bit-identical with every min/max kernel") {
+    std::vector<double> x(100'003);
+    for (size_t i = 0; i < x.size(); ++i) {
+        x[i] = double(i) * 1e-3;
+    }
+    std::vector<double> y = awkwardValues<double>(x.size(), 3);
+
+    KernelGuard guard;
+    setMinMaxKernel(MinMaxKernel::Scalar);
+    DecimatedValues expected = decimateValues(x, y, 1000, {.y_scale = -2, .y_offset = 0.5});
+    for (MinMaxKernel kernel : KERNELS) {
+        if (!setMinMaxKernel(kernel)) {
+            continue;
+        }
+        DecimatedValues values = decimateValues(x, y, 1000, {.y_scale = -2, .y_offset = 0.5});
+        REQUIRE(values.y_min.size() == expected.y_min.size());
+        for (size_t i = 0; i < values.y_min.size(); ++i) {
+            REQUIRE(std::bit_cast<uint64_t>(values.x[i]) == std::bit_cast<uint64_t>(expected.x[i]));
+            REQUIRE(std::bit_cast<uint64_t>(values.y_min[i]) == std::bit_cast<uint64_t>(expected.y_min[i]));
+            REQUIRE(std::bit_cast<uint64_t>(values.y_max[i]) == std::bit_cast<uint64_t>(expected.y_max[i]));
+        }
+    }
+}
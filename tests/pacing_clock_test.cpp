@@ -0,0 +1,53 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "pacing_clock.h"
+
+#include <chrono>
+
+TEST_CASE("Pacing clock advances sample time at the requested speed") {
+    using namespace std::chrono;
+    PacingClock clock;
+    auto start = steady_clock::now();
+    clock.restart(0);
+    // 50 ms of sample time at half speed takes 100 ms of wall time
+    for (int i = 1; i <= 50; ++i) {
+        clock.waitUntil(i * 1e-3, 0.5);
+    }
+    double elapsed = duration<double>(steady_clock::now() - start).count();
+    REQUIRE(elapsed >= 0.095);
+    // Loose bound because the test machine may be loaded
+    REQUIRE(elapsed < 0.3);
+}
+
+TEST_CASE("Pacing clock does not wait to catch up after a speed change") {
+    using namespace std::chrono;
+    PacingClock clock;
+    clock.restart(0);
+    clock.waitUntil(10e-3, 1);
+    auto start = steady_clock::now();
+    // Speed change restarts from the current point
+    clock.waitUntil(1000, 1e-3);
+    REQUIRE(steady_clock::now() - start < milliseconds(50));
+}
@@ -0,0 +1,181 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "plot_prefetch.h"
+#include "scrolling_buffer.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Plot prefetch gives prepared values only for the predicted request") {
+    std::vector<double> x{0, 1, 2, 3, 4, 5, 6, 7};
+    std::vector<double> y{0, 1, 4, 9, 16, 25, 36, 49};
+    int plot = 0;
+    int signal = 0;
+    PlotPrefetch::Request request{.plot = &plot, .signal = &signal, .start = 0, .end = 7, .count = 200, .transform = {.y_scale = 2}};
+    int decimations = 0;
+    auto decimate = [&]() {
+        ++decimations;
+        return decimateValues(x, y, request.count, request.transform);
+    };
+
+    WorkerPool pool(2);
+    PlotPrefetch prefetch;
+    prefetch.add(request, decimate);
+    prefetch.prepare(pool);
+    REQUIRE(decimations == 1);
+    DecimatedValues values = prefetch.take(request, decimate);
+    REQUIRE(decimations == 1);
+    REQUIRE(values.y_max.back() == 98);
+
+    // Taken values are not given twice
+    prefetch.take(request, decimate);
+    REQUIRE(decimations == 2);
+
+    // A plot that was zoomed since the previous frame decimates by itself
+    prefetch.add(request, decimate);
+    prefetch.prepare(pool);
+    PlotPrefetch::Request zoomed = request;
+    zoomed.end = 6;
+    prefetch.take(zoomed, decimate);
+    REQUIRE(decimations == 4);
+
+    // Values that were not taken are dropped on the next frame
+    prefetch.prepare(pool);
+    prefetch.take(request, decimate);
+    REQUIRE(decimations == 5);
+}
+
+TEST_CASE("Plot prefetch prepares the next frame in the background") {
+    std::vector<double> values(4);
+    std::vector<std::unique_ptr<Scalar>> scalars;
+    ScrollingBuffer buffer(50'000);
+    for (size_t i = 0; i < values.size(); ++i) {
+        auto scalar = std::make_unique<Scalar>();
+        scalar->id = i;
+        scalar->name = "value" + std::to_string(i);
+        scalar->group = "test";
+        scalar->alias = scalar->name;
+        scalar->updateDisplayNames();
+        scalar->src = &values[i];
+        buffer.startSampling(scalar.get());
+        scalars.push_back(std::move(scalar));
+    }
+    buffer.emptyTempBuffers();
+
+    // Sampling continues while the frames are prepared
+    std::atomic<bool> sampling = true;
+    std::thread sampler([&]() {
+        for (int row = 0; sampling; ++row) {
+            for (size_t i = 0; i < values.size(); ++i) {
+                values[i] = std::sin(row * 1e-3 * double(i + 1));
+            }
+            buffer.sample(row * 1e-3);
+        }
+    });
+
+    WorkerPool pool(2);
+    PlotPrefetch prefetch;
+    int plot = 0;
+    double now = 0;
+    for (int frame = 0; frame < 50; ++frame) {
+        prefetch.wait();
+        for (size_t i = 0; frame > 0 && i < scalars.size(); ++i) {
+            Scalar* scalar = scalars[i].get();
+            bool decimated = false;
+            DecimatedValues prepared = prefetch.take({.plot = &plot, .signal = scalar, .start = now - 10, .end = now, .count = 500},
+                                                     [&]() {
+                                                         decimated = true;
+                                                         return DecimatedValues{};
+                                                     });
+            REQUIRE(!decimated);
+            DecimatedValues expected = buffer.getValuesInTimeRange(scalar, now - 10, now, 500);
+            REQUIRE(prepared.x == expected.x);
+            REQUIRE(prepared.y_min == expected.y_min);
+            REQUIRE(prepared.y_max == expected.y_max);
+        }
+
+        buffer.emptyTempBuffers();
+        now = buffer.latestTime();
+        for (std::unique_ptr<Scalar> const& scalar : scalars) {
+            prefetch.add({.plot = &plot, .signal = scalar.get(), .start = now - 10, .end = now, .count = 500},
+                         [&buffer, scalar = scalar.get(), now]() {
+                             return buffer.getValuesInTimeRange(scalar, now - 10, now, 500);
+                         });
+        }
+        prefetch.start(pool);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    prefetch.wait();
+    sampling = false;
+    sampler.join();
+}
+
+TEST_CASE("Scrolling buffer decimates plots of the same scalar in parallel") {
+    std::vector<double> values(8);
+    std::vector<std::unique_ptr<Scalar>> scalars;
+    ScrollingBuffer buffer(50'000);
+    for (size_t i = 0; i < values.size(); ++i) {
+        auto scalar = std::make_unique<Scalar>();
+        scalar->id = i;
+        scalar->name = "value" + std::to_string(i);
+        scalar->group = "test";
+        scalar->alias = scalar->name;
+        scalar->updateDisplayNames();
+        scalar->src = &values[i];
+        buffer.startSampling(scalar.get());
+        scalars.push_back(std::move(scalar));
+    }
+    buffer.emptyTempBuffers();
+
+    WorkerPool pool(3);
+    int row = 0;
+    for (int frame = 0; frame < 50; ++frame) {
+        for (int end = row + 500; row < end; ++row) {
+            for (size_t i = 0; i < values.size(); ++i) {
+                values[i] = std::sin(row * 1e-3 * double(i + 1));
+            }
+            buffer.sample(row * 1e-3);
+        }
+        buffer.emptyTempBuffers();
+
+        // Each scalar is in two plots of the same size so that the plots
+        // share buckets
+        double now = buffer.latestTime();
+        std::vector<DecimatedValues> parallel(2 * scalars.size());
+        pool.parallelFor(parallel.size(), [&](size_t i) {
+            parallel[i] = buffer.getValuesInTimeRange(scalars[i / 2].get(), now - 10, now, 1000);
+        });
+        for (size_t i = 0; i < parallel.size(); ++i) {
+            DecimatedValues expected = buffer.getValuesInTimeRange(scalars[i / 2].get(), now - 10, now, 1000);
+            REQUIRE(parallel[i].x == expected.x);
+            REQUIRE(parallel[i].y_min == expected.y_min);
+            REQUIRE(parallel[i].y_max == expected.y_max);
+        }
+    }
+}
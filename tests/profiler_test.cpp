@@ -0,0 +1,64 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "profiler.h"
+
+#include <chrono>
+
+TEST_CASE("Profiler keeps totals and the newest durations of a section") {
+    using namespace std::chrono;
+    Profiler profiler;
+    for (int i = 1; i <= int(Profiler::HISTORY_SIZE) + 10; ++i) {
+        profiler.record(ProfileSection::Sampling, microseconds(i));
+    }
+
+    Profiler::Totals totals = profiler.totals(ProfileSection::Sampling);
+    REQUIRE(totals.count == Profiler::HISTORY_SIZE + 10);
+    REQUIRE(totals.max_time == (Profiler::HISTORY_SIZE + 10) * 1e-6);
+
+    std::vector<float> history = profiler.history(ProfileSection::Sampling);
+    REQUIRE(history.size() == Profiler::HISTORY_SIZE);
+    REQUIRE(history.front() == 11.0f);
+    REQUIRE(history.back() == float(Profiler::HISTORY_SIZE + 10));
+    REQUIRE(profiler.totals(ProfileSection::Scripts).count == 0);
+
+    profiler.reset();
+    REQUIRE(profiler.totals(ProfileSection::Sampling).count == 0);
+    REQUIRE(profiler.history(ProfileSection::Sampling).empty());
+}
+
+TEST_CASE("Profile scope records only while profiling is enabled") {
+    Profiler profiler;
+    {
+        ProfileScope scope(profiler, ProfileSection::Frame);
+    }
+    REQUIRE(profiler.totals(ProfileSection::Frame).count == 0);
+
+    profiler.setEnabled(true);
+    {
+        ProfileScope scope(profiler, ProfileSection::Frame);
+        scope.stop();
+    }
+    REQUIRE(profiler.totals(ProfileSection::Frame).count == 1);
+}
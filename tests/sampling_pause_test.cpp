@@ -0,0 +1,148 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "background_sampler.h"
+#include "sampling_pause.h"
+#include "scrolling_buffer.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Pausing the sampling waits for the sampling domains") {
+    double value = 0;
+    auto scalar = std::make_unique<Scalar>();
+    scalar->name = "value";
+    scalar->group = "test";
+    scalar->alias = scalar->name;
+    scalar->updateDisplayNames();
+    scalar->src = &value;
+    ScrollingBuffer buffer(1000);
+    buffer.startSampling(scalar.get());
+    buffer.emptyTempBuffers();
+
+    std::atomic<bool> paused = false;
+    SamplingPause pause(paused);
+    std::atomic<bool> sampling = true;
+    std::atomic<int> samples = 0;
+    std::thread domain_thread([&]() {
+        for (int i = 0; sampling; ++i) {
+            pause.sampleDomain([&] {
+                value = i;
+                buffer.sample(i * 1e-3);
+                ++samples;
+            });
+        }
+    });
+
+    for (int i = 0; i < 20; ++i) {
+        bool was_paused = pause.pauseSampling();
+        REQUIRE_FALSE(was_paused);
+        // Nothing is sampled while paused so the buffer can be used freely
+        int paused_samples = samples;
+        buffer.emptyTempBuffers();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        REQUIRE(samples == paused_samples);
+        pause.setPaused(was_paused);
+        while (samples == paused_samples) {
+            std::this_thread::yield();
+        }
+    }
+    sampling = false;
+    domain_thread.join();
+}
+
+TEST_CASE("Pausing the sampling waits for the main sampling thread") {
+    std::atomic<bool> paused = true;
+    SamplingPause pause(paused);
+    std::atomic<bool> sampling = true;
+    std::atomic<int> samples = 0;
+    std::thread sampling_thread([&]() {
+        // Sampling starts paused
+        pause.waitWhilePaused();
+        while (sampling) {
+            ++samples;
+            if (paused) {
+                pause.waitWhilePaused();
+            }
+        }
+    });
+
+    REQUIRE(pause.pauseSampling());
+    pause.setPaused(false);
+    for (int i = 0; i < 20; ++i) {
+        while (samples < 10 * i) {
+            std::this_thread::yield();
+        }
+        REQUIRE_FALSE(pause.pauseSampling());
+        int paused_samples = samples;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        REQUIRE(samples == paused_samples);
+        pause.setPaused(false);
+    }
+    sampling = false;
+    pause.setPaused(false);
+    sampling_thread.join();
+}
+
+TEST_CASE("Only the sampling thread acknowledges the pause") {
+    std::atomic<bool> paused = true;
+    SamplingPause pause(paused);
+    std::atomic<bool> sampling = true;
+    std::atomic<int> samples = 0;
+    std::unique_ptr<BackgroundSampler> sampler;
+    sampler = std::make_unique<BackgroundSampler>(1e-4, [&](double) {
+        ++samples;
+        if (paused) {
+            pause.waitWhilePaused(sampler->isSamplingThread());
+        }
+    });
+    sampler->start();
+    // Sampling starts paused
+    while (samples == 0) {
+        std::this_thread::yield();
+    }
+    pause.setPaused(false);
+    while (samples < 3) {
+        std::this_thread::yield();
+    }
+
+    // The application pauses while the background thread samples
+    std::thread application([&]() {
+        REQUIRE_FALSE(sampler->isSamplingThread());
+        pause.pause(sampler->isSamplingThread());
+    });
+    while (!paused) {
+        std::this_thread::yield();
+    }
+    REQUIRE(pause.pauseSampling());
+    int paused_samples = samples;
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    REQUIRE(samples == paused_samples);
+    pause.setPaused(false);
+    application.join();
+    sampler->stop();
+}
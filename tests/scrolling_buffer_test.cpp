@@ -0,0 +1,929 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "sampling_domain.h"
+#include "scrolling_buffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::unique_ptr<Scalar> makeScalar(double* value) {
+    auto scalar = std::make_unique<Scalar>();
+    scalar->name = "value";
+    scalar->group = "test";
+    scalar->alias = scalar->name;
+    scalar->updateDisplayNames();
+    scalar->src = value;
+    return scalar;
+}
+
+std::vector<double> allSamples(ScrollingBuffer& buffer, Scalar* scalar) {
+    auto time_idx = buffer.getTimeIndices(-1e9, 1e9);
+    return buffer.getSamplesInRange(scalar, time_idx);
+}
+
+} // namespace
+
+TEST_CASE("Sample ring rejects rows when full and accepts them after drain") {
+    SampleRing ring(4, 2);
+    for (int i = 0; i < 4; ++i) {
+        double* row = ring.beginWrite();
+        REQUIRE(row != nullptr);
+        row[0] = i;
+        row[1] = -i;
+        ring.commitWrite();
+    }
+    CHECK(ring.beginWrite() == nullptr);
+
+    std::vector<double> drained;
+    CHECK(ring.drain([&](std::span<double const> row) { drained.push_back(row[0]); }) == 4);
+    CHECK(drained == std::vector<double>{0, 1, 2, 3});
+    CHECK(ring.beginWrite() != nullptr);
+}
+
+TEST_CASE("Scrolling buffer drains committed samples into history") {
+    double value = 0;
+    auto scalar = makeScalar(&value);
+    ScrollingBuffer buffer(100);
+    buffer.startSampling(scalar.get());
+    // Layout changes are published to the sampling thread on the next drain
+    buffer.emptyTempBuffers();
+
+    for (int i = 1; i <= 5; ++i) {
+        value = 10 * i;
+        buffer.sample(i);
+    }
+    buffer.emptyTempBuffers();
+
+    CHECK(buffer.latestTime() == 5);
+    CHECK(allSamples(buffer, scalar.get()) == std::vector<double>{10, 20, 30, 40, 50});
+}
+
+TEST_CASE("Scrolling buffer shifts only the samples taken before a time jump") {
+    double value = 0;
+    auto scalar = makeScalar(&value);
+    ScrollingBuffer buffer(100);
+    buffer.startSampling(scalar.get());
+    buffer.emptyTempBuffers();
+
+    buffer.sample(1);
+    buffer.sample(2);
+    buffer.emptyTempBuffers();
+    buffer.sample(3);
+    // Jump back from 3 to 0.5 before the next sample at 0.75
+    buffer.shiftTime(-2.5);
+    buffer.sample(0.75);
+    buffer.emptyTempBuffers();
+
+    auto time_idx = buffer.getTimeIndices(-1e9, 1e9);
+    std::vector<double> time = buffer.getTimeInRange(time_idx);
+    CHECK(time == std::vector<double>{-1.5, -0.5, 0.5, 0.75});
+    CHECK(buffer.latestTime() == 0.75);
+    CHECK(buffer.getDiscontinuities(-1e9, 1e9) == std::vector<double>{0.75});
+    CHECK(buffer.getDiscontinuities(0.8, 1e9).empty());
+}
+
+TEST_CASE("Scrolling buffer reports dropped samples instead of blocking") {
+    double value = 0;
+    auto scalar = makeScalar(&value);
+    ScrollingBuffer buffer(int32_t(1e6));
+    buffer.startSampling(scalar.get());
+    buffer.emptyTempBuffers();
+
+    size_t const sample_count = 1 << 17;
+    for (size_t i = 0; i < sample_count; ++i) {
+        buffer.sample(double(i));
+    }
+    buffer.emptyTempBuffers();
+    size_t dropped = buffer.takeDroppedSampleCount();
+    CHECK(dropped > 0);
+    CHECK(buffer.takeDroppedSampleCount() == 0);
+
+    // The ring grows after a drop so the same burst fits next time
+    for (size_t i = 0; i < sample_count; ++i) {
+        buffer.sample(double(sample_count + i));
+    }
+    buffer.emptyTempBuffers();
+    CHECK(buffer.takeDroppedSampleCount() == 0);
+}
+
+TEST_CASE("Scrolling buffer keeps sampled rows consistent across threads") {
+    double value = 0;
+    auto scalar = makeScalar(&value);
+    ScrollingBuffer buffer(int32_t(1e6));
+    buffer.startSampling(scalar.get());
+    buffer.emptyTempBuffers();
+
+    std::atomic<bool> done = false;
+    std::jthread producer([&] {
+        for (int i = 0; i < 200'000; ++i) {
+            value = i;
+            buffer.sample(i);
+        }
+        done = true;
+    });
+    while (!done) {
+        buffer.emptyTempBuffers();
+    }
+    producer.join();
+    buffer.emptyTempBuffers();
+
+    auto time_idx = buffer.getTimeIndices(-1e9, 1e9);
+    std::vector<double> time = buffer.getTimeInRange(time_idx);
+    std::vector<double> samples = buffer.getSamplesInRange(scalar.get(), time_idx);
+    REQUIRE(time.size() == samples.size());
+    REQUIRE(!time.empty());
+    for (size_t i = 0; i < time.size(); ++i) {
+        CHECK(time[i] == samples[i]);
+        if (i > 0) {
+            CHECK(time[i] > time[i - 1]);
+        }
+    }
+}
+
+TEST_CASE("Scrolling buffer fills scalars missing from a channel with NAN") {
+    double a = 1;
+    double b = 2;
+    auto scalar_a = makeScalar(&a);
+    auto scalar_b = makeScalar(&b);
+    ScrollingBuffer buffer(4);
+    buffer.startSampling(scalar_a.get());
+    buffer.emptyTempBuffers();
+    for (int i = 0; i < 4; ++i) {
+        buffer.sample(i);
+    }
+    buffer.startSampling(scalar_b.get());
+    buffer.sample(4);
+    buffer.emptyTempBuffers();
+    buffer.sample(5);
+    buffer.emptyTempBuffers();
+
+    std::vector<double> samples_b = allSamples(buffer, scalar_b.get());
+    REQUIRE(samples_b.size() == 4);
+    CHECK(std::isnan(samples_b[0]));
+    CHECK(std::isnan(samples_b[1]));
+    CHECK(std::isnan(samples_b[2]));
+    CHECK(samples_b[3] == 2);
+}
+
+TEST_CASE("Scrolling buffer reuses the slot of a stopped scalar") {
+    double a = 1;
+    double b = 2;
+    auto scalar_a = makeScalar(&a);
+    auto scalar_b = makeScalar(&b);
+    ScrollingBuffer buffer(8);
+    buffer.startSampling(scalar_a.get());
+    buffer.emptyTempBuffers();
+    buffer.sample(0);
+    buffer.sample(1);
+    // Rows of the stopped scalar still in the ring must not end up in the new one
+    buffer.stopSampling(scalar_a.get());
+    buffer.startSampling(scalar_b.get());
+    buffer.emptyTempBuffers();
+    buffer.sample(2);
+    buffer.emptyTempBuffers();
+
+    CHECK_FALSE(buffer.isScalarSampled(scalar_a.get()));
+    std::vector<double> samples_b = allSamples(buffer, scalar_b.get());
+    REQUIRE(samples_b.size() == 3);
+    CHECK(std::isnan(samples_b[0]));
+    CHECK(std::isnan(samples_b[1]));
+    CHECK(samples_b[2] == 2);
+}
+
+TEST_CASE("Scrolling buffer keeps the newest samples when resized") {
+    double value = 0;
+    auto scalar = makeScalar(&value);
+    ScrollingBuffer buffer(4);
+    buffer.startSampling(scalar.get());
+    buffer.emptyTempBuffers();
+    for (int i = 0; i < 6; ++i) {
+        value = i;
+        buffer.sample(i);
+    }
+    buffer.emptyTempBuffers();
+
+    buffer.setBufferSize(3);
+    CHECK(allSamples(buffer, scalar.get()) == std::vector<double>{3, 4, 5});
+    buffer.setBufferSize(10);
+    CHECK(allSamples(buffer, scalar.get()) == std::vector<double>{3, 4, 5});
+    value = 6;
+    buffer.sample(6);
+    buffer.emptyTempBuffers();
+    CHECK(allSamples(buffer, scalar.get()) == std::vector<double>{3, 4, 5, 6});
+}
+
+TEST_CASE("Scrolling buffer moves kept samples over several drains after a resize") {
+    constexpr int SCALAR_COUNT = 64;
+    constexpr int ROWS = 40000;
+    std::vector<double> values(SCALAR_COUNT);
+    std::vector<std::unique_ptr<Scalar>> scalars;
+    ScrollingBuffer buffer(ROWS);
+    for (double& value : values) {
+        scalars.push_back(makeScalar(&value));
+        buffer.startSampling(scalars.back().get());
+    }
+    buffer.emptyTempBuffers();
+    auto sample = [&](int row) {
+        for (int i = 0; i < SCALAR_COUNT; ++i) {
+            values[i] = row + i;
+        }
+        buffer.sample(row);
+        if (row % 1000 == 999) {
+            buffer.emptyTempBuffers();
+        }
+    };
+    for (int row = 0; row < ROWS; ++row) {
+        sample(row);
+    }
+    buffer.emptyTempBuffers();
+
+    buffer.setBufferSize(2 * ROWS);
+    CHECK(buffer.resizing());
+    // Rows sampled during the resize go straight to the new columns
+    for (int row = ROWS; row < ROWS + 1000; ++row) {
+        sample(row);
+    }
+    while (buffer.resizing()) {
+        buffer.emptyTempBuffers();
+    }
+
+    auto time_idx = buffer.getTimeIndices(-1e9, 1e9);
+    std::vector<double> time = buffer.getTimeInRange(time_idx);
+    for (int i = 0; i < SCALAR_COUNT; i += 21) {
+        std::vector<double> samples = allSamples(buffer, scalars[i].get());
+        REQUIRE(samples.size() == ROWS + 1000);
+        for (size_t row = 0; row < samples.size(); ++row) {
+            REQUIRE(samples[row] == double(row + i));
+        }
+        // Pyramid blocks were moved along with the samples
+        DecimatedValues expected = decimateValues(time, samples, 1000);
+        DecimatedValues values = buffer.getValuesInRange(scalars[i].get(), time_idx, 1000);
+        CHECK(values.y_min == expected.y_min);
+        CHECK(values.y_max == expected.y_max);
+    }
+}
+
+TEST_CASE("Scrolling buffer stores rarely changing scalars as runs") {
+    double value = 0;
+    auto scalar = makeScalar(&value);
+    ScrollingBuffer buffer(20000);
+    buffer.startSampling(scalar.get());
+    buffer.emptyTempBuffers();
+    std::vector<double> expected;
+    auto sample = [&](int row, double new_value) {
+        value = new_value;
+        expected.push_back(new_value);
+        buffer.sample(row);
+        if (row % 500 == 499) {
+            buffer.emptyTempBuffers();
+        }
+    };
+
+    int row = 0;
+    for (; row < 12000; ++row) {
+        sample(row, row / 1000);
+    }
+    buffer.emptyTempBuffers();
+    CHECK(buffer.isStoredAsRuns(scalar.get()));
+    CHECK(allSamples(buffer, scalar.get()) == expected);
+
+    auto time_idx = buffer.getTimeIndices(2500, 4499);
+    DecimatedValues values = buffer.getValuesInRange(scalar.get(), time_idx, 1000);
+    REQUIRE(values.x.size() == 1000);
+    CHECK(values.y_min.front() == 2);
+    CHECK(values.y_max.back() == 4);
+    for (size_t i = 0; i < values.x.size(); ++i) {
+        CHECK(values.y_min[i] == values.y_max[i]);
+    }
+
+    // Noise goes back to a column without losing the runs
+    for (; row < 18000; ++row) {
+        sample(row, row % 2 == 0 ? row : -row);
+    }
+    buffer.emptyTempBuffers();
+    CHECK_FALSE(buffer.isStoredAsRuns(scalar.get()));
+    CHECK(allSamples(buffer, scalar.get()) == expected);
+    time_idx = buffer.getTimeIndices(-1e9, 1e9);
+    DecimatedValues decoded = buffer.getValuesInRange(scalar.get(), time_idx, 500);
+    DecimatedValues scanned = decimateValues(buffer.getTimeInRange(time_idx), expected, 500);
+    CHECK(decoded.y_min == scanned.y_min);
+    CHECK(decoded.y_max == scanned.y_max);
+}
+
+TEST_CASE("Min/max pyramid answers any range like a scan") {
+    constexpr size_t CAPACITY = 3000;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> dist(-100, 100);
+    std::vector<double> values(10'000);
+    for (double& value : values) {
+        value = rng() % 50 == 0 ? NAN : dist(rng);
+    }
+    MinMaxPyramid pyramid;
+    pyramid.reset(CAPACITY);
+    for (size_t k = 0; k < values.size(); ++k) {
+        pyramid.add(k, values[k]);
+    }
+
+    auto scan = [&](uint64_t begin, uint64_t end, double& lo, double& hi) {
+        for (uint64_t k = begin; k < end; ++k) {
+            lo = MIN(values[k], lo);
+            hi = MAX(values[k], hi);
+        }
+    };
+    for (int i = 0; i < 1000; ++i) {
+        uint64_t first = values.size() - CAPACITY + rng() % CAPACITY;
+        uint64_t last = first + rng() % (values.size() - first + 1);
+        double expected_min = INFINITY;
+        double expected_max = -INFINITY;
+        scan(first, last, expected_min, expected_max);
+        double min = INFINITY;
+        double max = -INFINITY;
+        pyramid.minMax(first, last, [&](uint64_t begin, uint64_t end) { scan(begin, end, min, max); }, min, max);
+        REQUIRE(min == expected_min);
+        REQUIRE(max == expected_max);
+    }
+}
+
+TEST_CASE("Scrolling buffer decimates from the pyramid like from the samples") {
+    double value = 0;
+    double slow_value = 0;
+    auto scalar = makeScalar(&value);
+    auto slow_scalar = makeScalar(&slow_value);
+    slow_scalar->sample_divider = 3;
+    ScrollingBuffer buffer(5000);
+    buffer.startSampling(scalar.get());
+    buffer.startSampling(slow_scalar.get());
+    buffer.emptyTempBuffers();
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> dist(-1, 1);
+    int row = 0;
+    auto sample = [&](int count) {
+        for (int end = row + count; row < end; ++row) {
+            value = rng() % 100 == 0 ? NAN : dist(rng);
+            slow_value = dist(rng);
+            buffer.sample(row * 1e-3);
+            if (row % 1000 == 999) {
+                buffer.emptyTempBuffers();
+            }
+        }
+        buffer.emptyTempBuffers();
+    };
+    auto check_matches_scan = [&](Scalar* s) {
+        auto time_idx = buffer.getTimeIndices(-1e9, 1e9);
+        std::vector<double> time = buffer.getTimeInRange(time_idx);
+        std::vector<double> samples = buffer.getSamplesInRange(s, time_idx);
+        DecimatedValues expected = decimateValues(time, samples, 300, {.y_scale = 2, .y_offset = 1});
+        DecimatedValues values = buffer.getValuesInRange(s, time_idx, 300, 2, 1);
+        REQUIRE(values.y_min.size() == expected.y_min.size());
+        for (size_t i = 0; i < values.y_min.size(); ++i) {
+            REQUIRE(std::bit_cast<uint64_t>(values.y_min[i]) == std::bit_cast<uint64_t>(expected.y_min[i]));
+            REQUIRE(std::bit_cast<uint64_t>(values.y_max[i]) == std::bit_cast<uint64_t>(expected.y_max[i]));
+        }
+    };
+
+    sample(12'345);
+    check_matches_scan(scalar.get());
+    buffer.setBufferSize(9000);
+    sample(2000);
+    check_matches_scan(scalar.get());
+    buffer.setBufferSize(3001);
+    sample(777);
+    check_matches_scan(scalar.get());
+
+    // A divided scalar holds each sample over several rows so only the
+    // buckets are compared against its own samples
+    auto time_idx = buffer.getTimeIndices(-1e9, 1e9);
+    DecimatedValues values = buffer.getValuesInRange(slow_scalar.get(), time_idx, 100);
+    double expected_min = INFINITY;
+    double expected_max = -INFINITY;
+    for (double sample : buffer.getSamplesInRange(slow_scalar.get(), time_idx)) {
+        expected_min = MIN(sample, expected_min);
+        expected_max = MAX(sample, expected_max);
+    }
+    CHECK(std::ranges::min(values.y_min) == expected_min);
+    CHECK(std::ranges::max(values.y_max) == expected_max);
+}
+
+TEST_CASE("Decimation cache computes only the buckets that scrolled in") {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> dist(-1, 1);
+    std::vector<double> samples(20'000);
+    for (double& sample : samples) {
+        sample = dist(rng);
+    }
+    auto time = [&](uint64_t k) { return double(k); };
+    size_t min_max_calls = 0;
+    auto min_max = [&](uint64_t begin, uint64_t end, double& lo, double& hi) {
+        ++min_max_calls;
+        for (uint64_t k = begin; k < end; ++k) {
+            lo = MIN(samples[k], lo);
+            hi = MAX(samples[k], hi);
+        }
+    };
+
+    uint64_t const window = 1000;
+    uint64_t bucket_size = DecimationCache::bucketSize(window, 200);
+    CHECK(bucket_size == 8);
+    DecimationCache cache(bucket_size);
+    for (uint64_t last = window; last <= samples.size(); last += 37) {
+        // Ring of the newest 4000 samples that is plotted up to the newest one
+        uint64_t stored_first = last > 4000 ? last - 4000 : 0;
+        min_max_calls = 0;
+        DecimatedValues values = cache.decimate(last - window, last, stored_first, last, time, min_max, {});
+        if (last > window) {
+            // New buckets and the partial one at the end
+            CHECK(min_max_calls <= 37 / bucket_size + 2);
+        }
+
+        DecimationCache fresh(bucket_size);
+        DecimatedValues expected = fresh.decimate(last - window, last, stored_first, last, time, min_max, {});
+        REQUIRE(values.x == expected.x);
+        REQUIRE(values.y_min == expected.y_min);
+        REQUIRE(values.y_max == expected.y_max);
+        CHECK(cache.size() <= values.x.size());
+
+        uint64_t first_bucket = (last - window) / bucket_size;
+        for (size_t i = 0; i < values.x.size(); ++i) {
+            uint64_t begin = (first_bucket + i) * bucket_size;
+            uint64_t end = MIN(begin + bucket_size, last);
+            auto [lo, hi] = std::minmax_element(samples.begin() + ptrdiff_t(begin), samples.begin() + ptrdiff_t(end));
+            REQUIRE(values.y_min[i] == *lo);
+            REQUIRE(values.y_max[i] == *hi);
+        }
+    }
+}
+
+TEST_CASE("Scrolling buffer plots cached buckets like freshly decimated ones") {
+    double value = 0;
+    double slow_value = 0;
+    auto scalar = makeScalar(&value);
+    auto slow_scalar = makeScalar(&slow_value);
+    slow_scalar->sample_divider = 4;
+    ScrollingBuffer live(20'000);
+    ScrollingBuffer fresh(20'000);
+    for (ScrollingBuffer* buffer : {&live, &fresh}) {
+        buffer->startSampling(scalar.get());
+        buffer->startSampling(slow_scalar.get());
+        buffer->emptyTempBuffers();
+    }
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> dist(-1, 1);
+    int row = 0;
+    // Frames of samples where only the live buffer is plotted
+    auto run = [&](int frames) {
+        for (int frame = 0; frame < frames; ++frame) {
+            for (int end = row + 123; row < end; ++row) {
+                value = dist(rng);
+                slow_value = dist(rng);
+                live.sample(row * 1e-3);
+                fresh.sample(row * 1e-3);
+            }
+            live.emptyTempBuffers();
+            fresh.emptyTempBuffers();
+            double now = live.latestTime();
+            live.getValuesInTimeRange(scalar.get(), now - 5, now, 700, 2, 1);
+            live.getValuesInTimeRange(slow_scalar.get(), now - 5, now, 700);
+        }
+    };
+    auto check_same = [&](Scalar* s) {
+        double now = live.latestTime();
+        DecimatedValues values = live.getValuesInTimeRange(s, now - 5, now, 700, 2, 1);
+        DecimatedValues expected = fresh.getValuesInTimeRange(s, now - 5, now, 700, 2, 1);
+        REQUIRE(values.x == expected.x);
+        REQUIRE(values.y_min == expected.y_min);
+        REQUIRE(values.y_max == expected.y_max);
+    };
+
+    run(100);
+    check_same(scalar.get());
+    check_same(slow_scalar.get());
+
+    live.shiftTime(-3);
+    fresh.shiftTime(-3);
+    run(20);
+    check_same(scalar.get());
+
+    live.setBufferSize(8000);
+    fresh.setBufferSize(8000);
+    run(50);
+    check_same(scalar.get());
+    check_same(slow_scalar.get());
+}
+
+TEST_CASE("Sampling plan reads every source type") {
+    int8_t i8 = -8;
+    uint16_t u16 = 16;
+    float f = 0.5f;
+    double d = 1.5;
+    int64_t i64 = -64;
+    double custom = 3;
+    std::vector<ValueSource> sources = {&d,
+                                        ReadWriteFn([&](std::optional<double> v) {
+                                            if (v) {
+                                                custom = *v;
+                                            }
+                                            return custom;
+                                        }),
+                                        &i8,
+                                        &f,
+                                        &u16,
+                                        &i64};
+    SamplingPlan plan(sources);
+    REQUIRE(plan.size() == sources.size());
+
+    std::vector<double> values(plan.size());
+    plan.gather(values.data());
+    for (size_t i = 0; i < values.size(); ++i) {
+        CHECK(values[i] == getSourceValue(sources[plan.order()[i]]));
+    }
+    // Callables are sampled last
+    CHECK(plan.order().back() == 1);
+}
+
+TEST_CASE("Scrolling buffer keeps narrow sources exact") {
+    int16_t value = 0;
+    auto scalar = std::make_unique<Scalar>();
+    scalar->src = &value;
+    double other = 0;
+    auto other_scalar = makeScalar(&other);
+    ScrollingBuffer buffer(16);
+    buffer.startSampling(other_scalar.get());
+    buffer.emptyTempBuffers();
+    buffer.sample(0);
+    buffer.sample(1);
+    buffer.startSampling(scalar.get());
+    buffer.emptyTempBuffers();
+    double time = 2;
+    for (int16_t v : {int16_t(-32768), int16_t(7), int16_t(32767)}) {
+        value = v;
+        buffer.sample(time++);
+    }
+    buffer.emptyTempBuffers();
+
+    std::vector<double> samples = allSamples(buffer, scalar.get());
+    REQUIRE(samples.size() == 5);
+    CHECK(std::isnan(samples[0]));
+    CHECK(std::isnan(samples[1]));
+    CHECK(samples[2] == -32768);
+    CHECK(samples[3] == 7);
+    CHECK(samples[4] == 32767);
+
+    // Samples taken before sampling started are not plotted
+    DecimatedValues decimated = buffer.getValuesInRange(scalar.get(), buffer.getTimeIndices(-1e9, 1e9), ALL_SAMPLES);
+    REQUIRE(decimated.y_min.size() == 5);
+    CHECK(std::isnan(decimated.y_min[1]));
+    CHECK(decimated.y_min[2] == -32768);
+    CHECK(decimated.y_max[4] == 32767);
+}
+
+TEST_CASE("Time axis stores regular sampling as a single run") {
+    TimeAxis time;
+    double t = 0;
+    for (int i = 0; i < 100'000; ++i) {
+        time.push(t);
+        t += 1e-4;
+    }
+    CHECK(time.size() == 100'000);
+    CHECK(time.runCount() <= 2);
+    CHECK(time.at(0) == 0);
+    CHECK(std::abs(time.at(50'000) - 5.0) < 1e-9);
+    CHECK(time.lastAtOrBefore(5.00005) == 50'000);
+    CHECK(time.lastAtOrBefore(-1) == 0);
+    CHECK(time.lastAtOrBefore(1e9) == 99'999);
+
+    time.popFront(60'000);
+    CHECK(time.begin() == 60'000);
+    CHECK(time.lastAtOrBefore(0) == 60'000);
+}
+
+TEST_CASE("Time axis keeps irregular timestamps exact") {
+    TimeAxis time;
+    std::vector<double> stamps = {0, 0.1, 0.2, 0.3, 0.35, 1.0, 1.7, 1.8, 1.9, 2.0, 2.1};
+    for (double t : stamps) {
+        time.push(t);
+    }
+    std::vector<double> copied;
+    time.copy(0, stamps.size(), std::back_inserter(copied));
+    REQUIRE(copied.size() == stamps.size());
+    for (size_t i = 0; i < stamps.size(); ++i) {
+        CHECK(std::abs(copied[i] - stamps[i]) < 1e-12);
+        CHECK(time.lastAtOrBefore(stamps[i] + 1e-9) == i);
+    }
+    CHECK(time.lastAtOrBefore(0.5) == 4);
+
+    time.shift(10);
+    CHECK(std::abs(time.at(5) - 11.0) < 1e-12);
+    CHECK(time.lastAtOrBefore(10.5) == 4);
+    time.push(12.5);
+    CHECK(time.discontinuities() == std::deque<uint64_t>{stamps.size()});
+    CHECK(time.back() == 12.5);
+    time.popFront(stamps.size());
+    CHECK(time.discontinuities().empty());
+    time.popFront();
+    CHECK(time.empty());
+    CHECK(time.begin() == stamps.size() + 1);
+}
+
+TEST_CASE("Scrolling buffer keeps min and max of samples older than the raw history") {
+    double value = 0;
+    auto scalar = makeScalar(&value);
+    ScrollingBuffer buffer(100);
+    buffer.startSampling(scalar.get());
+    buffer.emptyTempBuffers();
+
+    // Sawtooth from 0 to 63 so that every finest bucket has min 0 and max 63
+    int const sample_count = 64 * 200;
+    for (int i = 0; i < sample_count; ++i) {
+        value = i % 64;
+        buffer.sample(i);
+        if (i % 1000 == 0) {
+            buffer.emptyTempBuffers();
+        }
+    }
+    buffer.emptyTempBuffers();
+
+    // Raw history alone only covers the last 100 samples
+    auto time_idx = buffer.getTimeIndices(-1e9, 1e9);
+    CHECK(buffer.getTimeInRange(time_idx).front() == sample_count - 100);
+
+    DecimatedValues values = buffer.getValuesInTimeRange(scalar.get(), 0, sample_count, 1000);
+    REQUIRE(!values.x.empty());
+    CHECK(values.x.front() < 64);
+    CHECK(values.x.back() > sample_count - 64);
+    for (size_t i = 1; i < values.x.size(); ++i) {
+        CHECK(values.x[i] > values.x[i - 1]);
+    }
+    for (size_t i = 0; i < values.x.size(); ++i) {
+        if (values.x[i] < sample_count - 100) {
+            CHECK(values.y_min[i] == 0);
+            CHECK(values.y_max[i] == 63);
+        }
+    }
+}
+
+TEST_CASE("Scrolling buffer keeps the downsampled history when the buffer is resized") {
+    double value = 0;
+    auto scalar = makeScalar(&value);
+    ScrollingBuffer buffer(100);
+    buffer.startSampling(scalar.get());
+    buffer.emptyTempBuffers();
+
+    int const sample_count = 64 * 200;
+    for (int i = 0; i < sample_count; ++i) {
+        value = i % 64;
+        buffer.sample(i);
+        if (i % 1000 == 0) {
+            buffer.emptyTempBuffers();
+        }
+    }
+    buffer.emptyTempBuffers();
+
+    // The tiers grow with the buffer and shrink back to their minimum size
+    for (int32_t buffer_size : {100'000, 100}) {
+        buffer.setBufferSize(buffer_size);
+        for (int i = 0; i < 100; ++i) {
+            buffer.emptyTempBuffers();
+        }
+        DecimatedValues values = buffer.getValuesInTimeRange(scalar.get(), 0, sample_count, 1000);
+        REQUIRE(!values.x.empty());
+        CHECK(values.x.front() < 64);
+        CHECK(values.y_min.front() == 0);
+        CHECK(values.y_max.front() == 63);
+    }
+}
+
+TEST_CASE("History file keeps the newest samples readable after the writer is gone") {
+    std::string filename = "scrolling_buffer_test" + std::string(HISTORY_FILE_EXTENSION);
+    double value = 0;
+    double late_value = 0;
+    auto scalar = makeScalar(&value);
+    auto late_scalar = makeScalar(&late_value);
+    late_scalar->name = "late";
+    late_scalar->updateDisplayNames();
+    {
+        ScrollingBuffer buffer(100);
+        auto file = HistoryFile::create(filename, 16);
+        REQUIRE(file.has_value());
+        buffer.setHistoryFile(std::move(*file));
+        buffer.startSampling(scalar.get());
+        buffer.emptyTempBuffers();
+        for (int i = 0; i < 30; ++i) {
+            value = i;
+            late_value = -i;
+            buffer.sample(i);
+            if (i == 24) {
+                buffer.emptyTempBuffers();
+                buffer.startSampling(late_scalar.get());
+                buffer.emptyTempBuffers();
+            }
+        }
+        buffer.emptyTempBuffers();
+    }
+
+    auto data = readHistoryFile(filename);
+    REQUIRE(data.has_value());
+    REQUIRE(data->names.size() == 3);
+    CHECK(data->names[0] == "time");
+    CHECK(data->names[1] == scalar->name_and_group);
+    CHECK(data->names[2] == late_scalar->name_and_group);
+    // Oldest row of a full ring may be partially overwritten so it is skipped
+    REQUIRE(data->columns[0].size() == 15);
+    for (size_t i = 0; i < 15; ++i) {
+        double t = double(15 + i);
+        CHECK(data->columns[0][i] == t);
+        CHECK(data->columns[1][i] == t);
+        if (t < 25) {
+            CHECK(std::isnan(data->columns[2][i]));
+        } else {
+            CHECK(data->columns[2][i] == -t);
+        }
+    }
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("Scrolling buffer samples a batch with values from blocks") {
+    double value = 5;
+    int16_t narrow = 0;
+    double live = 7;
+    auto scalar = makeScalar(&value);
+    auto narrow_scalar = makeScalar(nullptr);
+    narrow_scalar->src = &narrow;
+    auto live_scalar = makeScalar(&live);
+    ScrollingBuffer buffer(100);
+    buffer.startSampling(scalar.get());
+    buffer.startSampling(narrow_scalar.get());
+    buffer.startSampling(live_scalar.get());
+    buffer.emptyTempBuffers();
+
+    std::vector<double> times = {0, 1, 2, 3};
+    std::vector<double> values = {10, 11, 12, 13};
+    std::vector<double> narrow_values = {-1, -2, -3, 40000};
+    std::vector<DbgGui_SampleBlock> blocks = {{&value, values.data()}, {&narrow, narrow_values.data()}};
+    buffer.sampleBatch(times, blocks);
+    buffer.emptyTempBuffers();
+
+    CHECK(allSamples(buffer, scalar.get()) == values);
+    CHECK(allSamples(buffer, narrow_scalar.get()) == std::vector<double>{-1, -2, -3, INT16_MAX});
+    CHECK(allSamples(buffer, live_scalar.get()) == std::vector<double>{7, 7, 7, 7});
+    CHECK(buffer.getTimeInRange(buffer.getTimeIndices(-1e9, 1e9)) == times);
+}
+
+TEST_CASE("Scrolling buffer samples divided scalars on every Nth row") {
+    double fast = 0;
+    double slow = 0;
+    auto fast_scalar = makeScalar(&fast);
+    auto slow_scalar = makeScalar(&slow);
+    slow_scalar->sample_divider = 3;
+    ScrollingBuffer buffer(8);
+    buffer.startSampling(fast_scalar.get());
+    buffer.startSampling(slow_scalar.get());
+    buffer.emptyTempBuffers();
+
+    for (int i = 0; i < 20; ++i) {
+        fast = i;
+        slow = 100 + i;
+        buffer.sample(i);
+    }
+    buffer.emptyTempBuffers();
+
+    // Raw history has rows 12..19. The slow scalar was read on rows 12, 15 and
+    // 18 and is held until the next sample on the common time axis.
+    auto time_idx = buffer.getTimeIndices(-1e9, 1e9);
+    CHECK(buffer.getTimeInRange(time_idx) == std::vector<double>{12, 13, 14, 15, 16, 17, 18, 19});
+    CHECK(allSamples(buffer, fast_scalar.get()) == std::vector<double>{12, 13, 14, 15, 16, 17, 18, 19});
+    CHECK(allSamples(buffer, slow_scalar.get()) == std::vector<double>{112, 112, 112, 115, 115, 115, 118, 118});
+
+    DecimatedValues values = buffer.getValuesInRange(slow_scalar.get(), time_idx, 100);
+    CHECK(values.x == std::vector<double>{12, 15, 18});
+    CHECK(values.y_min == std::vector<double>{112, 115, 118});
+
+    // Starting within a hold uses the sample taken before the range
+    auto mouse_idx = buffer.getTimeIndices(17, 17);
+    values = buffer.getValuesInRange(slow_scalar.get(), mouse_idx, 1);
+    CHECK(values.y_min == std::vector<double>{115});
+
+    buffer.setBufferSize(5);
+    CHECK(allSamples(buffer, slow_scalar.get()) == std::vector<double>{115, 115, 115, 118, 118});
+    buffer.setBufferSize(16);
+    for (int i = 20; i < 24; ++i) {
+        slow = 100 + i;
+        buffer.sample(i);
+    }
+    buffer.emptyTempBuffers();
+    CHECK(allSamples(buffer, slow_scalar.get()) == std::vector<double>{115, 115, 115, 118, 118, 118, 121, 121, 121});
+}
+
+TEST_CASE("Sampling domains are sampled from their own threads") {
+    double main_value = 0;
+    double domain_value = 0;
+    auto main_scalar = makeScalar(&main_value);
+    auto domain_scalar = makeScalar(&domain_value);
+    ScrollingBuffer main_sampler(1000);
+    DbgGui_SamplingDomain domain{"plant", ScrollingBuffer(1000)};
+    std::vector<std::unique_ptr<Vector2D>> vectors;
+    setSamplingDomain(domain_scalar.get(), &domain, main_sampler, vectors);
+    REQUIRE(&domainSampler(main_scalar.get(), main_sampler) == &main_sampler);
+    REQUIRE(&domainSampler(domain_scalar.get(), main_sampler) == &domain.sampler);
+    domainSampler(main_scalar.get(), main_sampler).startSampling(main_scalar.get());
+    domainSampler(domain_scalar.get(), main_sampler).startSampling(domain_scalar.get());
+    main_sampler.emptyTempBuffers();
+    domain.sampler.emptyTempBuffers();
+
+    // Different time bases and rates without any shared state
+    std::thread main_thread([&]() {
+        for (int i = 0; i < 100; ++i) {
+            main_value = i;
+            main_sampler.sample(i * 1e-3);
+        }
+    });
+    std::thread domain_thread([&]() {
+        for (int i = 0; i < 50; ++i) {
+            domain_value = -i;
+            domain.sampler.sample(0.5 + i * 2e-3);
+        }
+    });
+    main_thread.join();
+    domain_thread.join();
+    main_sampler.emptyTempBuffers();
+    domain.sampler.emptyTempBuffers();
+
+    std::vector<double> main_samples = allSamples(main_sampler, main_scalar.get());
+    std::vector<double> domain_samples = allSamples(domain.sampler, domain_scalar.get());
+    REQUIRE(main_samples.size() == 100);
+    REQUIRE(domain_samples.size() == 50);
+    CHECK(main_samples.back() == 99);
+    CHECK(domain_samples.back() == -49);
+    CHECK(main_sampler.latestTime() == 99e-3);
+    CHECK(domain.sampler.latestTime() == 0.5 + 49 * 2e-3);
+    CHECK_FALSE(main_sampler.isScalarSampled(domain_scalar.get()));
+}
+
+TEST_CASE("Vector components move between sampling domains together") {
+    double x_value = 1;
+    double y_value = 2;
+    auto x = makeScalar(&x_value);
+    auto y = makeScalar(&y_value);
+    std::vector<std::unique_ptr<Vector2D>> vectors;
+    vectors.push_back(std::make_unique<Vector2D>(Vector2D{.id = 0, .group = "test", .name = "vector", .name_and_group = "vector (test)", .x = x.get(), .y = y.get()}));
+    ScrollingBuffer main_sampler(100);
+    DbgGui_SamplingDomain domain{"plant", ScrollingBuffer(100)};
+    main_sampler.startSampling(x.get());
+    main_sampler.startSampling(y.get());
+    main_sampler.emptyTempBuffers();
+    main_sampler.sample(0);
+    main_sampler.emptyTempBuffers();
+
+    setSamplingDomain(y.get(), &domain, main_sampler, vectors);
+    CHECK(x->sampling_domain == &domain);
+    CHECK(y->sampling_domain == &domain);
+    CHECK_FALSE(main_sampler.isScalarSampled(x.get()));
+    CHECK_FALSE(main_sampler.isScalarSampled(y.get()));
+    REQUIRE(domain.sampler.isScalarSampled(x.get()));
+    REQUIRE(domain.sampler.isScalarSampled(y.get()));
+
+    // Samples of the old time base are not kept
+    domain.sampler.emptyTempBuffers();
+    domain.sampler.sample(10);
+    domain.sampler.emptyTempBuffers();
+    CHECK(allSamples(domain.sampler, x.get()) == std::vector<double>{1});
+    CHECK(allSamples(domain.sampler, y.get()) == std::vector<double>{2});
+
+    // Back to the main sampling
+    setSamplingDomain(x.get(), nullptr, main_sampler, vectors);
+    CHECK(y->sampling_domain == nullptr);
+    CHECK(main_sampler.isScalarSampled(x.get()));
+    CHECK(main_sampler.isScalarSampled(y.get()));
+    CHECK_FALSE(domain.sampler.isScalarSampled(y.get()));
+}
@@ -0,0 +1,89 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "triggered_capture.h"
+
+#include <vector>
+
+TEST_CASE("Capture keeps pre- and post-trigger samples around a rising edge") {
+    double trigger = 0;
+    int16_t other = 0;
+    CaptureEngine engine;
+    engine.arm({{.name = "trigger", .src = &trigger}, {.name = "other", .src = &other, .scale = 2}},
+               {.pre_samples = 3, .post_samples = 2, .edge = TriggerEdge::Rising, .level = 5, .rearm = false});
+
+    for (int i = 0; i < 20; ++i) {
+        trigger = i % 10;
+        other = int16_t(i);
+        engine.sample(i);
+    }
+
+    std::vector<Capture> captures = engine.takeCaptures();
+    REQUIRE(captures.size() == 1);
+    Capture const& capture = captures[0];
+    CHECK(capture.trigger_time == 5);
+    CHECK(capture.names == std::vector<std::string>{"trigger", "other"});
+    CHECK(capture.time == std::vector<double>{2, 3, 4, 5, 6, 7});
+    CHECK(capture.values[0] == std::vector<double>{2, 3, 4, 5, 6, 7});
+    CHECK(capture.values[1] == std::vector<double>{4, 6, 8, 10, 12, 14});
+    CHECK(!engine.triggers()[0].armed());
+}
+
+TEST_CASE("Capture rearms and triggers again") {
+    double trigger = 0;
+    CaptureEngine engine;
+    engine.arm({{.name = "trigger", .src = &trigger}},
+               {.pre_samples = 100, .post_samples = 1, .edge = TriggerEdge::Falling, .level = 0.5, .rearm = true});
+
+    for (int i = 0; i < 10; ++i) {
+        trigger = i % 2;
+        engine.sample(i);
+    }
+
+    std::vector<Capture> captures = engine.takeCaptures();
+    REQUIRE(captures.size() == 4);
+    CHECK(captures[0].trigger_time == 2);
+    // Pre-trigger ring is not filled yet so the first capture is shorter
+    CHECK(captures[0].time == std::vector<double>{0, 1, 2, 3});
+    CHECK(captures[3].trigger_time == 8);
+    CHECK(captures[3].time.size() == 10);
+    CHECK(engine.triggers()[0].captureCount() == 4);
+}
+
+TEST_CASE("Capture evaluates the trigger on every row of a batch") {
+    double trigger = 0;
+    CaptureEngine engine;
+    engine.arm({{.name = "trigger", .src = &trigger}},
+               {.pre_samples = 1, .post_samples = 1, .edge = TriggerEdge::Either, .level = 1.5, .rearm = false});
+
+    std::vector<double> times = {0, 1, 2, 3};
+    std::vector<double> values = {0, 1, 2, 3};
+    std::vector<DbgGui_SampleBlock> blocks = {{&trigger, values.data()}};
+    engine.sampleBatch(times, blocks);
+
+    std::vector<Capture> captures = engine.takeCaptures();
+    REQUIRE(captures.size() == 1);
+    CHECK(captures[0].time == std::vector<double>{1, 2, 3});
+    CHECK(captures[0].values[0] == std::vector<double>{1, 2, 3});
+}
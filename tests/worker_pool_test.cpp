@@ -0,0 +1,102 @@
+// MIT License
+//
+// Copyright (c) 2026 vvainola
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "worker_pool.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Worker pool runs every iteration once") {
+    WorkerPool pool(3);
+    // Loops run back to back so that threads from the previous loop may still
+    // be finishing when the next one starts
+    for (size_t count : {0, 1, 2, 7, 1000, 5, 3}) {
+        std::vector<std::atomic<int>> calls(count);
+        pool.parallelFor(count, [&](size_t i) {
+            ++calls[i];
+        });
+        for (size_t i = 0; i < count; ++i) {
+            REQUIRE(calls[i] == 1);
+        }
+    }
+    for (int loop = 0; loop < 1000; ++loop) {
+        std::atomic<int> sum = 0;
+        pool.parallelFor(10, [&](size_t i) { sum += int(i); });
+        REQUIRE(sum == 45);
+    }
+}
+
+TEST_CASE("Worker pool spreads iterations over threads") {
+    WorkerPool pool(3);
+    std::atomic<int> waiting = 0;
+    // Every iteration waits for the others so the loop finishes only if each
+    // iteration runs on its own thread
+    pool.parallelFor(4, [&](size_t) {
+        ++waiting;
+        while (waiting < 4) {
+            std::this_thread::yield();
+        }
+    });
+    REQUIRE(waiting == 4);
+}
+
+TEST_CASE("Worker pool without threads runs the loop on the calling thread") {
+    WorkerPool pool(0);
+    REQUIRE(pool.threadCount() == 0);
+    std::thread::id caller = std::this_thread::get_id();
+    std::vector<size_t> order;
+    pool.parallelFor(5, [&](size_t i) {
+        REQUIRE(std::this_thread::get_id() == caller);
+        order.push_back(i);
+    });
+    REQUIRE(order == std::vector<size_t>{0, 1, 2, 3, 4});
+}
+
+TEST_CASE("Worker pool runs a started loop until waited for") {
+    WorkerPool pool(2);
+    pool.wait();
+    std::atomic<bool> started = false;
+    std::vector<std::atomic<int>> calls(100);
+    pool.start(calls.size(), [&](size_t i) {
+        started = true;
+        ++calls[i];
+    });
+    // The threads work on the loop while the caller does something else
+    while (!started) {
+        std::this_thread::yield();
+    }
+    pool.wait();
+    for (std::atomic<int> const& call : calls) {
+        REQUIRE(call == 1);
+    }
+
+    // Without threads the loop runs in wait()
+    WorkerPool serial(0);
+    int sum = 0;
+    serial.start(10, [&](size_t i) { sum += int(i); });
+    REQUIRE(sum == 0);
+    serial.wait();
+    REQUIRE(sum == 45);
+}